@@ -0,0 +1,108 @@
+#ifndef GENETICALGORITHM_BENCH_HARNESS_H
+#define GENETICALGORITHM_BENCH_HARNESS_H
+
+#include <cstdlib> // size_t
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Bench {
+
+    /**
+     * Prevent the compiler from discarding the computation of a value.
+     * @tparam T Type of the value
+     * @param value The value
+     */
+    template<class T>
+    void doNotOptimize(const T &value);
+
+    /**
+     * The measure of a benchmark.
+     */
+    struct Result final {
+        std::string name; /**< Name of the measured operation */
+        size_t n; /**< Number of bits of individuals */
+        size_t nc; /**< Number of customers, 0 if not relevant */
+        double nsPerOp; /**< Median time of an operation over the repetitions, in nanoseconds */
+        double minNsPerOp; /**< Best time of an operation over the repetitions, in nanoseconds */
+        double opsPerSecond; /**< Throughput deduced from nsPerOp */
+    };
+
+    /**
+     * A minimal benchmark harness.
+     * Each benchmark is a function running a given number of operations. The harness
+     * calibrates the number of operations so that a run lasts at least the minimal
+     * time, does a warmup run, then times several repetitions and keeps the median.
+     * Results are printed as CSV on the standard output, and optionally written as a
+     * JSON array, so that two commits can be compared with a plain diff tool.
+     * <p>
+     * Command line options:
+     * --filter TEXT: only run benchmarks whose name contains TEXT;
+     * --repetitions COUNT: number of timed runs (5 by default);
+     * --min-time SECONDS: minimal duration of a run (0.01 by default);
+     * --json FILE: also write the results in FILE.
+     */
+    class Harness final {
+
+    public:
+        Harness() = delete;
+        Harness(const Harness&) = delete;
+        Harness(Harness&&) = delete;
+
+        /**
+         * Read the options of the command line.
+         * @param argc Number of arguments
+         * @param argv The arguments
+         */
+        Harness(int argc, char **argv);
+
+        /**
+         * Write the JSON output if requested.
+         */
+        ~Harness();
+
+        Harness &operator=(const Harness&) = delete;
+        Harness &operator=(Harness&&) = delete;
+
+        /**
+         * @param name Name of an operation
+         * @return true if the operation passes the filter, to skip costly setups
+         */
+        bool isSelected(const std::string &name) const;
+
+        /**
+         * Measure an operation.
+         * @tparam Function Callable as function(size_t count), running count operations
+         * @param name Name of the operation
+         * @param n Number of bits of individuals
+         * @param nc Number of customers, 0 if not relevant
+         * @param function The function running the operations
+         */
+        template<class Function>
+        void run(const std::string &name, size_t n, size_t nc, Function function);
+
+        /**
+         * @return The results measured so far
+         */
+        const std::vector<Result> &getResults() const;
+
+    private:
+        /**
+         * Write the results as a JSON array.
+         * @param out The output stream
+         */
+        void writeJson(std::ostream &out) const;
+
+        std::string filter; /**< Only benchmarks whose name contains it are run */
+        unsigned int repetitions; /**< Number of timed runs */
+        double minTime; /**< Minimal duration of a run in seconds */
+        std::string jsonPath; /**< Path of the JSON output, empty if not requested */
+        std::vector<Result> results; /**< Results measured so far */
+
+    };
+
+}
+
+#include "Harness.tpp"
+
+#endif //GENETICALGORITHM_BENCH_HARNESS_H
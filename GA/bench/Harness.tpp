@@ -0,0 +1,109 @@
+#include <algorithm> // min_element, sort
+#include <chrono>
+#include <cstring> // strcmp
+#include <fstream>
+#include <iostream>
+
+template<class T>
+void Bench::doNotOptimize(const T &value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline Bench::Harness::Harness(int argc, char **argv) :
+        filter(),
+        repetitions(5),
+        minTime(0.01),
+        jsonPath(),
+        results() {
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (std::strcmp(argv[i], "--filter") == 0) {
+            filter = argv[i + 1];
+        } else if (std::strcmp(argv[i], "--repetitions") == 0) {
+            repetitions = (unsigned int) std::max(1, std::atoi(argv[i + 1]));
+        } else if (std::strcmp(argv[i], "--min-time") == 0) {
+            minTime = std::atof(argv[i + 1]);
+        } else if (std::strcmp(argv[i], "--json") == 0) {
+            jsonPath = argv[i + 1];
+        } else {
+            std::cerr << "Unknown option " << argv[i] << std::endl;
+        }
+    }
+    std::cout << "name,n,nc,ns_per_op,min_ns_per_op,ops_per_second" << std::endl;
+}
+
+inline Bench::Harness::~Harness() {
+    if (!jsonPath.empty()) {
+        std::ofstream file(jsonPath);
+        if (!file.is_open()) {
+            std::cerr << "Can't open file " << jsonPath << std::endl;
+        } else {
+            this->writeJson(file);
+        }
+    }
+}
+
+inline bool Bench::Harness::isSelected(const std::string &name) const {
+    return name.find(filter) != std::string::npos;
+}
+
+template<class Function>
+void Bench::Harness::run(const std::string &name, size_t n, size_t nc, Function function) {
+    using Clock = std::chrono::steady_clock;
+    using Duration = std::chrono::duration<double>;
+
+    if (!this->isSelected(name)) {
+        return;
+    }
+
+    // Calibration, which also serves as warmup
+    size_t count = 1;
+    double elapsed;
+    while (true) {
+        auto start = Clock::now();
+        function(count);
+        elapsed = Duration(Clock::now() - start).count();
+        if (elapsed >= minTime) {
+            break;
+        }
+        count = elapsed > 0. ? std::max(count * 2, (size_t) ((double) count * 1.2 * minTime / elapsed)) : count * 2;
+    }
+
+    std::vector<double> times(repetitions);
+    for (double &time: times) {
+        auto start = Clock::now();
+        function(count);
+        time = Duration(Clock::now() - start).count() * 1e9 / (double) count;
+    }
+    std::sort(times.begin(), times.end());
+
+    Result result;
+    result.name = name;
+    result.n = n;
+    result.nc = nc;
+    result.nsPerOp = times[times.size() / 2];
+    result.minNsPerOp = times.front();
+    result.opsPerSecond = 1e9 / result.nsPerOp;
+    results.push_back(result);
+
+    std::cout << result.name << "," << result.n << "," << result.nc << "," << result.nsPerOp << ","
+              << result.minNsPerOp << "," << result.opsPerSecond << std::endl;
+}
+
+inline const std::vector<Bench::Result> &Bench::Harness::getResults() const {
+    return results;
+}
+
+inline void Bench::Harness::writeJson(std::ostream &out) const {
+    out << "[";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result &result = results[i];
+        out << (i == 0 ? "\n" : ",\n")
+            << "  {\"name\": \"" << result.name << "\""
+            << ", \"n\": " << result.n
+            << ", \"nc\": " << result.nc
+            << ", \"nsPerOp\": " << result.nsPerOp
+            << ", \"minNsPerOp\": " << result.minNsPerOp
+            << ", \"opsPerSecond\": " << result.opsPerSecond << "}";
+    }
+    out << "\n]\n";
+}
@@ -0,0 +1,336 @@
+#include <string>
+#include <vector>
+#include "Harness.h"
+#include "FacilityLocation/IncrementalEvaluator.h"
+#include "FacilityLocation/Objective.h"
+#include "GA/Crossover/MultiPointCrossover.h"
+#include "GA/Crossover/SinglePointCrossover.h"
+#include "GA/Mutation/RandomMutation.h"
+#include "GA/Objective/DeadBitInsertion.h"
+#include "GA/Objective/DuplicateBits.h"
+#include "GA/Objective/MixInformation.h"
+#include "GA/Population.h"
+#include "GA/Random.h"
+#include "GA/Selection/ElitismSelection.h"
+#include "GA/Selection/ProbabilistSelection.h"
+
+/*
+ * Micro-benchmarks of the operators, decoders and objectives, over a matrix of
+ * sizes of individuals and numbers of customers. One operation is one call to the
+ * functor, except for objectives where it is the evaluation of one individual.
+ * See Bench::Harness for the options and the output format.
+ */
+
+#define SEED 1 // Seed of the instances and of the random engines
+#define POOL 64 // Number of distinct individuals operations cycle through
+#define POPULATION 256 // Size of the population given to selections
+
+namespace {
+
+    /**
+     * Objective counting the set bits, whose cost is negligible next to the one of
+     * the decoders it is wrapped in.
+     */
+    template<size_t N>
+    class CountObjective final : public GA::Objective<GA::BinaryRepresentation<N>> {
+
+    public:
+        double operator()(const GA::BinaryRepresentation<N> &individual) override {
+            return (double) individual.count();
+        }
+
+    };
+
+    template<size_t N>
+    std::vector<GA::BinaryRepresentation<N>> randomIndividuals(size_t count, GA::RandomEngine &rnd) {
+        std::vector<GA::BinaryRepresentation<N>> individuals(count);
+        for (auto &individual: individuals) {
+            individual.randomize(rnd);
+        }
+        return individuals;
+    }
+
+    /**
+     * One operation is the evaluation of one individual, by batches of the whole pool.
+     */
+    template<class Objective, class Individual>
+    void benchEvaluate(Bench::Harness &harness, const std::string &name, size_t n, size_t numberCustomer,
+                       Objective &objective, const std::vector<Individual> &individuals) {
+        std::vector<double> scores(individuals.size());
+        harness.run(name, n, numberCustomer, [&](size_t count) {
+            for (size_t i = 0; i < count; i += individuals.size()) {
+                size_t batch = std::min<size_t>(individuals.size(), count - i);
+                objective.evaluate(individuals.data(), scores.data(), batch);
+                Bench::doNotOptimize(scores[0]);
+            }
+        });
+    }
+
+    template<size_t M, class Decoder>
+    void benchDecoder(Bench::Harness &harness, const std::string &name, size_t n, Decoder &decoder) {
+        GA::RandomEngine rnd(SEED);
+        benchEvaluate(harness, name, n, 0, decoder, randomIndividuals<M>(POOL, rnd));
+    }
+
+    template<size_t N>
+    void benchOperators(Bench::Harness &harness) {
+        using Individual = GA::BinaryRepresentation<N>;
+        GA::RandomEngine rnd(SEED);
+        std::vector<Individual> individuals = randomIndividuals<N>(POOL, rnd);
+
+        GA::SinglePointCrossover<Individual> singlePointCrossover;
+        harness.run("SinglePointCrossover", N, 0, [&](size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                Individual child = singlePointCrossover(individuals[i % POOL], individuals[(i + 1) % POOL], rnd);
+                Bench::doNotOptimize(child);
+            }
+        });
+
+        GA::MultiPointCrossover<Individual> multiPointCrossover(8);
+        harness.run("MultiPointCrossover", N, 0, [&](size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                Individual child = multiPointCrossover(individuals[i % POOL], individuals[(i + 1) % POOL], rnd);
+                Bench::doNotOptimize(child);
+            }
+        });
+
+        GA::RandomMutation<Individual> mutation(1. / N);
+        harness.run("RandomMutation", N, 0, [&](size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                mutation(individuals[i % POOL], rnd);
+                Bench::doNotOptimize(individuals[i % POOL]);
+            }
+        });
+
+        GA::Population<Individual> population;
+        population.reserve(POPULATION);
+        std::uniform_real_distribution<double> distrib(0., 1.);
+        for (size_t i = 0; i < POPULATION; ++i) {
+            population.add(distrib(rnd), individuals[i % POOL]);
+        }
+        population.sort();
+
+        GA::ElitismSelection<Individual> elitismSelection(0.05);
+        harness.run("ElitismSelection", N, 0, [&](size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                GA::Population<Individual> survivors = elitismSelection(population, rnd);
+                Bench::doNotOptimize(survivors);
+            }
+        });
+
+        GA::ProbabilistSelection<Individual> probabilistSelection;
+        harness.run("ProbabilistSelection", N, 0, [&](size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                GA::Population<Individual> survivors = probabilistSelection(population, rnd);
+                Bench::doNotOptimize(survivors);
+            }
+        });
+
+        CountObjective<N> countObjective;
+        GA::DuplicateBits<Individual, GA::BinaryRepresentation<2 * N>> duplicateBits(countObjective, 1);
+        benchDecoder<2 * N>(harness, "DuplicateBits", N, duplicateBits);
+        GA::DeadBitInsertion<Individual, GA::BinaryRepresentation<2 * N>> deadBitInsertion(countObjective);
+        benchDecoder<2 * N>(harness, "DeadBitInsertion", N, deadBitInsertion);
+        GA::MixInformation<Individual, GA::BinaryRepresentation<N + N / 8>> mixInformation(countObjective, N / 8 + 1);
+        benchDecoder<N + N / 8>(harness, "MixInformation", N, mixInformation);
+    }
+
+    template<size_t N>
+    void benchObjective(Bench::Harness &harness, size_t numberCustomer) {
+        using Individual = GA::BinaryRepresentation<N>;
+        FacilityLocation::Instance<N> instance = FacilityLocation::Instance<N>::randomInstance(numberCustomer, SEED);
+        FacilityLocation::Objective<Individual> objective(instance);
+        GA::RandomEngine rnd(SEED);
+        std::vector<Individual> individuals = randomIndividuals<N>(POOL, rnd);
+        benchEvaluate(harness, "FacilityLocationObjective", N, numberCustomer, objective, individuals);
+
+        // Neighbours of the first individual, one facility flipped
+        FacilityLocation::IncrementalEvaluator<N> evaluator(instance);
+        evaluator.reset(individuals[0]);
+        std::vector<Individual> neighbours(POOL, individuals[0]);
+        std::uniform_int_distribution<size_t> distrib(0, N - 1);
+        for (Individual &neighbour: neighbours) {
+            neighbour.flip(distrib(rnd));
+        }
+        harness.run("IncrementalEvaluator", N, numberCustomer, [&](size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                Bench::doNotOptimize(evaluator.evaluate(neighbours[i % POOL]));
+            }
+        });
+    }
+
+    std::string getKernelName(FacilityLocation::InstructionSet instructionSet) {
+        return std::string("FacilityLocationObjective/") + FacilityLocation::Kernel::getName(instructionSet);
+    }
+
+    /**
+     * The objective with each instruction set of its kernels supported by the processor.
+     */
+    template<size_t N>
+    void benchKernels(Bench::Harness &harness, size_t numberCustomer) {
+        using Individual = GA::BinaryRepresentation<N>;
+        std::vector<FacilityLocation::InstructionSet> instructionSets;
+        for (FacilityLocation::InstructionSet instructionSet: {FacilityLocation::InstructionSet::Scalar,
+                                                               FacilityLocation::InstructionSet::AVX2,
+                                                               FacilityLocation::InstructionSet::AVX512}) {
+            if (FacilityLocation::Kernel::isSupported(instructionSet) &&
+                harness.isSelected(getKernelName(instructionSet))) {
+                instructionSets.push_back(instructionSet);
+            }
+        }
+        if (instructionSets.empty()) {
+            return;
+        }
+
+        FacilityLocation::Instance<N> instance = FacilityLocation::Instance<N>::randomInstance(numberCustomer, SEED);
+        FacilityLocation::Objective<Individual> objective(instance);
+        GA::RandomEngine rnd(SEED);
+        std::vector<Individual> individuals = randomIndividuals<N>(POOL, rnd);
+        for (FacilityLocation::InstructionSet instructionSet: instructionSets) {
+            objective.setInstructionSet(instructionSet);
+            benchEvaluate(harness, getKernelName(instructionSet), N, numberCustomer, objective, individuals);
+        }
+    }
+
+    std::string getLayoutName(FacilityLocation::Layout layout) {
+        switch (layout) {
+            case FacilityLocation::Layout::FacilityMajor:
+                return "FacilityLocationLayout/FacilityMajor";
+            case FacilityLocation::Layout::CustomerMajor:
+                return "FacilityLocationLayout/CustomerMajor";
+            case FacilityLocation::Layout::Blocked:
+                return "FacilityLocationLayout/Blocked";
+        }
+        return "";
+    }
+
+    /**
+     * The objective with each layout of the distances, and the best instruction set.
+     */
+    template<size_t N>
+    void benchLayouts(Bench::Harness &harness, size_t numberCustomer) {
+        using Individual = GA::BinaryRepresentation<N>;
+        std::vector<FacilityLocation::Layout> layouts;
+        for (FacilityLocation::Layout layout: {FacilityLocation::Layout::FacilityMajor,
+                                               FacilityLocation::Layout::CustomerMajor,
+                                               FacilityLocation::Layout::Blocked}) {
+            if (harness.isSelected(getLayoutName(layout))) {
+                layouts.push_back(layout);
+            }
+        }
+        if (layouts.empty()) {
+            return;
+        }
+
+        FacilityLocation::Instance<N> instance = FacilityLocation::Instance<N>::randomInstance(numberCustomer, SEED);
+        GA::RandomEngine rnd(SEED);
+        std::vector<Individual> individuals = randomIndividuals<N>(POOL, rnd);
+        for (FacilityLocation::Layout layout: layouts) {
+            instance.setLayout(layout);
+            FacilityLocation::Objective<Individual> objective(instance);
+            benchEvaluate(harness, getLayoutName(layout), N, numberCustomer, objective, individuals);
+        }
+    }
+
+    std::string getPrecisionName(FacilityLocation::Precision precision) {
+        switch (precision) {
+            case FacilityLocation::Precision::Double:
+                return "FacilityLocationPrecision/Double";
+            case FacilityLocation::Precision::Float:
+                return "FacilityLocationPrecision/Float";
+            case FacilityLocation::Precision::Fixed16:
+                return "FacilityLocationPrecision/Fixed16";
+        }
+        return "";
+    }
+
+    /**
+     * The objective with each precision of the distances, and the best instruction set.
+     */
+    template<size_t N>
+    void benchPrecisions(Bench::Harness &harness, size_t numberCustomer) {
+        using Individual = GA::BinaryRepresentation<N>;
+        std::vector<FacilityLocation::Precision> precisions;
+        for (FacilityLocation::Precision precision: {FacilityLocation::Precision::Double,
+                                                     FacilityLocation::Precision::Float,
+                                                     FacilityLocation::Precision::Fixed16}) {
+            if (harness.isSelected(getPrecisionName(precision))) {
+                precisions.push_back(precision);
+            }
+        }
+        if (precisions.empty()) {
+            return;
+        }
+
+        FacilityLocation::Instance<N> instance = FacilityLocation::Instance<N>::randomInstance(numberCustomer, SEED);
+        GA::RandomEngine rnd(SEED);
+        std::vector<Individual> individuals = randomIndividuals<N>(POOL, rnd);
+        for (FacilityLocation::Precision precision: precisions) {
+            // From double each time, not to round twice
+            FacilityLocation::Instance<N> rounded(instance);
+            rounded.setPrecision(precision);
+            FacilityLocation::Objective<Individual> objective(rounded);
+            benchEvaluate(harness, getPrecisionName(precision), N, numberCustomer, objective, individuals);
+        }
+    }
+
+    /**
+     * The objective on a metric instance, without and with lists of the 64 nearest
+     * facilities of each customer, for individuals opening about one facility in 8.
+     */
+    template<size_t N>
+    void benchCandidates(Bench::Harness &harness, size_t numberCustomer) {
+        using Individual = GA::BinaryRepresentation<N>;
+        std::vector<size_t> candidateCounts;
+        for (size_t candidateCount: {size_t(0), size_t(64)}) {
+            if (harness.isSelected("FacilityLocationCandidates/" + std::to_string(candidateCount))) {
+                candidateCounts.push_back(candidateCount);
+            }
+        }
+        if (candidateCounts.empty()) {
+            return;
+        }
+
+        FacilityLocation::Instance<N> instance =
+                FacilityLocation::Instance<N>::randomMetricInstance(numberCustomer, SEED);
+        GA::RandomEngine rnd(SEED);
+        std::vector<Individual> individuals = randomIndividuals<N>(POOL, rnd);
+        for (Individual &individual: individuals) {
+            // The and of three random draws
+            for (size_t w = 0; w < individual.getWordCount(); ++w) {
+                individual.setWord(w, individual.getWord(w) & rnd() & rnd());
+            }
+        }
+        for (size_t candidateCount: candidateCounts) {
+            instance.setCandidateCount(candidateCount);
+            FacilityLocation::Objective<Individual> objective(instance);
+            const std::string name = "FacilityLocationCandidates/" + std::to_string(candidateCount);
+            benchEvaluate(harness, name, N, numberCustomer, objective, individuals);
+        }
+    }
+
+    template<size_t N>
+    void benchSize(Bench::Harness &harness) {
+        benchOperators<N>(harness);
+        benchObjective<N>(harness, 100);
+        benchObjective<N>(harness, 1000);
+    }
+
+}
+
+int main(int argc, char **argv) {
+    Bench::Harness harness(argc, argv);
+    benchSize<64>(harness);
+    benchSize<256>(harness);
+    benchSize<1024>(harness);
+    benchSize<4096>(harness);
+    benchKernels<100>(harness, 1000);
+    benchKernels<1000>(harness, 100000);
+    benchLayouts<100>(harness, 1000);
+    benchLayouts<1000>(harness, 100000);
+    benchPrecisions<100>(harness, 1000);
+    benchPrecisions<1000>(harness, 100000);
+    benchCandidates<1000>(harness, 10000);
+    benchCandidates<4096>(harness, 2000);
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include <chrono>
+#include <iostream>
+#include "FacilityLocation/Objective.h"
+#include "GA/Engine.h"
+#include "GA/Crossover/SinglePointCrossover.h"
+#include "GA/Mutation/RandomMutation.h"
+#include "GA/Selection/ElitismSelection.h"
+
+/*
+ * Compare the engine with abstract functors to the engine with statically known
+ * functors, on the same run: both engines start from the same seed and must reach
+ * the same score.
+ */
+
+#define NF 256 // Number of facilities
+#define NC 16 // Number of customers, kept low so that operators weigh in a generation
+#define SEED 1 // Seed of the instance and of the engines
+#define POPULATION 256 // Size of the population
+#define GENERATIONS 2000 // Number of generations of a run
+#define REPETITIONS 5 // Number of timed runs, the best one is reported
+
+using Individual = GA::BinaryRepresentation<NF>;
+using Objective = FacilityLocation::Objective<Individual>;
+using Crossover = GA::SinglePointCrossover<Individual>;
+using Mutation = GA::RandomMutation<Individual>;
+using Selection = GA::ElitismSelection<Individual>;
+
+using Clock = std::chrono::steady_clock;
+using Duration = std::chrono::duration<double>;
+
+template<class Engine>
+static double run(Engine &engine, double &score) {
+    double best = INFINITY;
+    for (unsigned int repetition = 0; repetition < REPETITIONS; ++repetition) {
+        engine.setSeed(SEED);
+        engine.initialize(POPULATION);
+        auto start = Clock::now();
+        score = engine.step(GENERATIONS);
+        double elapsed = Duration(Clock::now() - start).count();
+        if (elapsed < best) {
+            best = elapsed;
+        }
+    }
+    return best;
+}
+
+int main() {
+    FacilityLocation::Instance<NF> instance = FacilityLocation::Instance<NF>::randomInstance(NC, SEED);
+    Objective objective(instance);
+    Crossover crossover;
+    Mutation mutation(1. / NF);
+    Selection selection(0.05);
+
+    GA::Engine<Individual> dynamicEngine(objective, crossover, mutation, selection);
+    GA::StaticEngine<Individual, Objective, Crossover, Mutation, Selection> staticEngine(objective, crossover,
+                                                                                        mutation, selection);
+
+    double dynamicScore, staticScore;
+    double dynamicTime = run(dynamicEngine, dynamicScore);
+    double staticTime = run(staticEngine, staticScore);
+
+    std::cout << "engine,ns_per_generation,score" << std::endl;
+    std::cout << "dynamic," << dynamicTime / GENERATIONS * 1e9 << "," << dynamicScore << std::endl;
+    std::cout << "static," << staticTime / GENERATIONS * 1e9 << "," << staticScore << std::endl;
+    std::cout << "speedup," << dynamicTime / staticTime << "," << std::endl;
+    return dynamicScore < staticScore || staticScore < dynamicScore ? 1 : 0;
+}
@@ -0,0 +1,250 @@
+#ifndef EXPERIMENT_RUNNER_H
+#define EXPERIMENT_RUNNER_H
+
+#include <cstdint> // uint64_t
+#include <cstdlib> // size_t
+#include <memory> // unique_ptr
+#include <string>
+#include <type_traits> // integral_constant
+#include <vector>
+
+#include "Experiment/Sweep.h"
+#include "FacilityLocation/Instance.h"
+#include "GA/Objective.h"
+#include "GA/Representation/BinaryRepresentation.h"
+
+namespace Experiment {
+
+    /**
+     * Run the experiments of a sweep on a facility location problem.
+     * Every replicate of every configuration is an independent job. Jobs are spread
+     * over a pool of threads, each job running a single-threaded engine for a budget
+     * of CPU time, so that results do not depend on the load of the machine.
+     * Replicate r of every configuration starts from the same seed, unless they set
+     * different seeds, so that configurations are compared on the same random draws.
+     * <p>
+     * Keys of the [instance] section:
+     * generator: random, metric, flawed-metric (default) or file;
+     * customers: number of customers, 1000 by default;
+     * facilities: number of facilities of generated instances, NF by default and the
+     * only value allowed unless NF is 0, 100 by default otherwise;
+     * seed: seed of the generator, 1 by default;
+     * ordered: true to order the positions of metric instances, false by default;
+     * file: the instance to load with the file generator, a text or binary file, see
+     * FacilityLocation::Instance::load;
+     * layout: facility-major (default), customer-major or blocked, the order of the
+     * distances in memory, see FacilityLocation::Layout;
+     * precision: double (default), float or fixed16, the storage of the distances and
+     * opening costs, see FacilityLocation::Precision for the error of scores;
+     * candidates: length of the lists of nearest facilities of each customer used by
+     * the objective, 0 (default) for none, see
+     * FacilityLocation::Instance::setCandidateCount.
+     * <p>
+     * Keys of the [run] section, which experiments can override but threads:
+     * output: directory of the results, output/NF-NC-SEED[-ordered] by default;
+     * threads: number of jobs run at the same time, 0 (default) for every hardware thread;
+     * seed: seed of the engines, 1 by default;
+     * cpu-time: CPU time of a replicate in seconds, initialization included, 1 by default;
+     * replicates: number of replicates of each configuration, 100 by default;
+     * trace-interval: minimal CPU time between two samples of a trace, 0 (default)
+     * to keep every generation.
+     * <p>
+     * Keys of an experiment:
+     * encoding: none (default), dead-bit, duplicate or mix, see GA::DeadBitInsertion,
+     * GA::DuplicateBits and GA::MixInformation;
+     * redundancy: ratio of the encoded size to the number of facilities, among 1
+     * (default), 1.5, 2, 3, 5, 7, 9 and 11, it must be 1 without encoding and an
+     * integer with duplicate;
+     * position, offset, range: parameter of the dead-bit, duplicate and mix encodings;
+     * crossover: single-point (default) or multi-point;
+     * points: number of points of the multi-point crossover, 1 by default;
+     * mutation: probability of mutation of a bit, times the number of facilities, 1 by
+     * default;
+     * selection: proportion of survivors of the elitism selection, 0.05 by default;
+     * population: size of the population, 128 by default.
+     * <p>
+     * The replicate r of a configuration records a sample after the initialization and
+     * after each generation in the trace output/configuration/r.trace, timed with the
+     * CPU time in seconds.
+     * <p>
+     * With NF = 0, the number of facilities is the one of the instance, and individuals
+     * are GA::BinaryRepresentation<0>. Encodings need a number of facilities fixed at
+     * compile time and are then rejected.
+     * @see GA::TraceWriter
+     * @tparam NF Number of facilities, 0 to take it from the instance
+     */
+    template<size_t NF>
+    class Runner final {
+
+    public:
+        /**
+         * Encodings of the individuals
+         */
+        enum class Encoding {
+            None, /**< Individuals are the facilities opened */
+            DeadBit, /**< GA::DeadBitInsertion */
+            Duplicate, /**< GA::DuplicateBits */
+            Mix /**< GA::MixInformation */
+        };
+
+    public:
+        Runner() = delete;
+        Runner(const Runner&) = delete;
+        Runner(Runner&&) = delete;
+
+        /**
+         * @param sweep The sweep to run, it must outlive the runner
+         */
+        explicit Runner(const Sweep &sweep);
+
+        ~Runner() = default;
+
+        Runner &operator=(const Runner&) = delete;
+        Runner &operator=(Runner&&) = delete;
+
+        /**
+         * Check every configuration and build the instance.
+         * Errors are reported on the standard error output.
+         * @return false if the sweep is invalid, nothing can then be run
+         */
+        bool prepare();
+
+        /**
+         * @return The instance of the problem, once prepared
+         */
+        const FacilityLocation::Instance<NF> &getInstance() const;
+
+        /**
+         * @return The number of jobs of the sweep, once prepared
+         */
+        size_t getJobCount() const;
+
+        /**
+         * @return The number of jobs run at the same time, once prepared
+         */
+        size_t getThreadCount() const;
+
+        /**
+         * Run every job, reporting the progress on the standard output.
+         * @return false if an output directory or file can not be created
+         */
+        bool run();
+
+    private:
+        /**
+         * Parameters of a configuration.
+         */
+        struct Setting {
+            std::string path; /**< Directory of the results */
+            Encoding encoding; /**< Encoding of the individuals */
+            unsigned int halfRedundancy; /**< Twice the ratio of the encoded size to the number of facilities */
+            unsigned long encodingParameter; /**< Position, offset or range of the encoding */
+            bool multiPoint; /**< Use the multi-point crossover */
+            unsigned long points; /**< Number of points of the multi-point crossover */
+            double mutation; /**< Probability of mutation of a bit */
+            double selection; /**< Proportion of survivors */
+            unsigned long population; /**< Size of the population */
+            double cpuTime; /**< CPU time of a replicate in seconds */
+            unsigned long replicates; /**< Number of replicates */
+            double traceInterval; /**< Minimal CPU time between two samples of a trace */
+            unsigned long seed; /**< Seed of the engines */
+        };
+
+        /**
+         * A replicate of a configuration.
+         */
+        struct Job {
+            const Setting *setting; /**< The configuration */
+            unsigned long replicate; /**< Index of the replicate */
+        };
+
+        /**
+         * Build the instance from the [instance] section.
+         * @return false if the section is invalid
+         */
+        bool prepareInstance();
+
+        /**
+         * Read the parameters of a configuration.
+         * @param configuration The configuration
+         * @param setting Receives the parameters
+         * @return false if the configuration is invalid
+         */
+        bool prepareSetting(const Configuration &configuration, Setting &setting) const;
+
+        /**
+         * Run a job with the size of individuals of its configuration.
+         * @param job The job
+         * @return false if the output file can not be created
+         */
+        bool runJob(const Job &job) const;
+
+        /**
+         * Dispatch a job on its encoding, with a number of facilities fixed at compile time.
+         * @param job The job
+         * @return false if the output file can not be created
+         */
+        bool runJob(const Job &job, std::true_type) const;
+
+        /**
+         * Run a job without encoding, with a number of facilities chosen at runtime.
+         * @param job The job
+         * @return false if the output file can not be created
+         */
+        bool runJob(const Job &job, std::false_type) const;
+
+        /**
+         * Run a job with an encoding of M bits.
+         * @tparam M Number of bits of the encoded individuals
+         * @param job The job
+         * @return false if the output file can not be created
+         */
+        template<size_t M>
+        bool runEncoded(const Job &job) const;
+
+        template<size_t M>
+        bool runDuplicate(const Job &job, GA::Objective<GA::BinaryRepresentation<NF>> &objective,
+                          std::true_type) const;
+
+        template<size_t M>
+        bool runDuplicate(const Job &job, GA::Objective<GA::BinaryRepresentation<NF>> &objective,
+                          std::false_type) const;
+
+        /**
+         * Run the engine of a job.
+         * @tparam M Number of bits of the individuals
+         * @param job The job
+         * @param objective The objective, decoding individuals if needed
+         * @return false if the output file can not be created
+         */
+        template<size_t M>
+        bool evolve(const Job &job, GA::Objective<GA::BinaryRepresentation<M>> &objective) const;
+
+        /**
+         * @param setting The configuration
+         * @param replicate Index of a replicate
+         * @return The seed of the engines of the replicate
+         */
+        static uint64_t getSeed(const Setting &setting, unsigned long replicate);
+
+        /**
+         * Create a directory and its missing parents.
+         * @param path Path of the directory
+         * @return false if a directory can not be created
+         */
+        static bool makeDirectories(const std::string &path);
+
+        const Sweep &sweep; /**< The sweep to run */
+        std::unique_ptr<FacilityLocation::Instance<NF>> instance; /**< Instance of the problem */
+        std::vector<Setting> settings; /**< Parameters of each configuration */
+        std::vector<Job> jobs; /**< Every replicate of every configuration */
+        std::string defaultOutput; /**< Directory of the results named after the instance */
+        unsigned long threadCount; /**< Number of jobs run at the same time */
+
+    };
+
+}
+
+#include "Experiment/Runner.tpp"
+
+#endif //EXPERIMENT_RUNNER_H
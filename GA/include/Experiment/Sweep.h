@@ -0,0 +1,159 @@
+#ifndef EXPERIMENT_SWEEP_H
+#define EXPERIMENT_SWEEP_H
+
+#include <map>
+#include <string>
+#include <utility> // pair
+#include <vector>
+
+namespace Experiment {
+
+    /**
+     * A named set of parameters, stored as strings and converted on demand.
+     */
+    class Configuration final {
+
+    public:
+        Configuration() = default;
+        Configuration(const Configuration&) = default;
+        Configuration(Configuration&&) = default;
+
+        /**
+         * @param name Name of the configuration
+         * @param parameters Values of the parameters, by name
+         */
+        Configuration(std::string name, std::map<std::string, std::string> parameters);
+
+        ~Configuration() = default;
+
+        Configuration &operator=(const Configuration&) = default;
+        Configuration &operator=(Configuration&&) = default;
+
+        /**
+         * @return The name of the configuration, also the path of its results
+         */
+        const std::string &getName() const;
+
+        /**
+         * @return The values of the parameters, by name
+         */
+        const std::map<std::string, std::string> &getParameters() const;
+
+        /**
+         * @param key Name of a parameter
+         * @return true if the parameter is set
+         */
+        bool has(const std::string &key) const;
+
+        /**
+         * Read a parameter as a string.
+         * @param key Name of the parameter
+         * @param value Receives the value, left untouched if the parameter is not set
+         * @return true
+         */
+        bool get(const std::string &key, std::string &value) const;
+
+        /**
+         * Read a parameter as a real number.
+         * @param key Name of the parameter
+         * @param value Receives the value, left untouched if the parameter is not set
+         * @return false if the value is not a number
+         */
+        bool get(const std::string &key, double &value) const;
+
+        /**
+         * Read a parameter as a non-negative integer.
+         * @param key Name of the parameter
+         * @param value Receives the value, left untouched if the parameter is not set
+         * @return false if the value is not a non-negative integer
+         */
+        bool get(const std::string &key, unsigned long &value) const;
+
+        /**
+         * Read a parameter as a boolean, written true or false.
+         * @param key Name of the parameter
+         * @param value Receives the value, left untouched if the parameter is not set
+         * @return false if the value is neither true nor false
+         */
+        bool get(const std::string &key, bool &value) const;
+
+    private:
+        std::string name; /**< Name of the configuration */
+        std::map<std::string, std::string> parameters; /**< Values of the parameters, by name */
+
+    };
+
+    /**
+     * The description of a set of experiments, read from a file.
+     * The file is made of sections, each one starting with a line [name] and followed
+     * by lines key = value. Everything after a # is a comment.
+     * <p>
+     * The sections [instance] and [run] describe the problem instance and the settings
+     * of the runner. Every other section describes an experiment. A value can be a
+     * comma-separated list: the experiment is then expanded into one configuration per
+     * element of the cartesian product of its lists. A configuration is named after
+     * its section and the values taken by the list-valued keys, joined by '_', or 0 if
+     * the section has no list. Configurations also inherit the keys of [run] they do
+     * not set.
+     */
+    class Sweep final {
+
+    public:
+        Sweep() = default;
+        Sweep(const Sweep&) = default;
+        Sweep(Sweep&&) = default;
+        ~Sweep() = default;
+
+        Sweep &operator=(const Sweep&) = default;
+        Sweep &operator=(Sweep&&) = default;
+
+        /**
+         * Read a sweep file, replacing the current content.
+         * Errors are reported on the standard error output, with their line.
+         * @param filename Path of the file
+         * @return false if the file can not be read or is malformed
+         */
+        bool load(const std::string &filename);
+
+        /**
+         * @return The content of the [instance] section
+         */
+        const Configuration &getInstance() const;
+
+        /**
+         * @return The content of the [run] section
+         */
+        const Configuration &getRun() const;
+
+        /**
+         * @return Every configuration of every experiment, in the order of the file
+         */
+        const std::vector<Configuration> &getConfigurations() const;
+
+    private:
+        using Section = std::vector<std::pair<std::string, std::vector<std::string>>>;
+
+        /**
+         * Append the configurations of an experiment.
+         * @param name Name of the section
+         * @param section Keys of the section with their list of values, in order
+         */
+        void expand(const std::string &name, const Section &section);
+
+        /**
+         * @param text A string
+         * @return The string without its leading and trailing blanks
+         */
+        static std::string trim(const std::string &text);
+
+        Configuration instance; /**< Content of the [instance] section */
+        Configuration run; /**< Content of the [run] section */
+        std::vector<Configuration> configurations; /**< Configurations of the experiments */
+
+    };
+
+}
+
+#include "Experiment/Sweep.tpp"
+
+#endif //EXPERIMENT_SWEEP_H
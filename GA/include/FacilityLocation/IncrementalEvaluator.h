@@ -0,0 +1,175 @@
+#ifndef FACILITYLOCATION_INCREMENTALEVALUATOR_H
+#define FACILITYLOCATION_INCREMENTALEVALUATOR_H
+
+#include <cstdlib> // size_t
+#include <vector>
+
+#include "FacilityLocation/Instance.h"
+#include "FacilityLocation/Kernel.h"
+#include "GA/Representation/BinaryRepresentation.h"
+
+namespace FacilityLocation {
+
+    /**
+     * Scores solutions close to a reference solution from the changes of its score.
+     * For each customer, the evaluator keeps the nearest and the second nearest open
+     * facility of the reference solution, and for each facility the customers it serves.
+     * The score change of closing a facility then costs a visit of the customers it
+     * serves, and the one of opening a facility a pass over a single row of distances,
+     * instead of every open row for a full evaluation.
+     * <p>
+     * Scores of evaluate, and the one of the reference solution after reset, are exactly
+     * the ones of FacilityLocation::Objective. Flips accumulate rounding errors in the
+     * score of the reference solution.
+     * @tparam NF Number of facilities, 0 if chosen at runtime
+     */
+    template<size_t NF>
+    class IncrementalEvaluator {
+
+    public:
+        using Individual = GA::BinaryRepresentation<NF>;
+
+        /**
+         * Index of a facility standing for no facility.
+         */
+        static constexpr size_t none = ~size_t(0);
+
+    public:
+        IncrementalEvaluator() = delete;
+        IncrementalEvaluator(const IncrementalEvaluator&) = default;
+        IncrementalEvaluator(IncrementalEvaluator&&) = default;
+
+        /**
+         * The reference solution opens no facility until the first call to reset.
+         * @param instance The instance, with the facility-major layout and the double
+         * precision, it must outlive the evaluator
+         */
+        explicit IncrementalEvaluator(const Instance<NF> &instance);
+
+        ~IncrementalEvaluator() = default;
+
+        IncrementalEvaluator &operator=(const IncrementalEvaluator&) = delete;
+        IncrementalEvaluator &operator=(IncrementalEvaluator&&) = delete;
+
+        /**
+         * Set the reference solution, with the cost of a full evaluation.
+         * @param solution The new reference solution
+         */
+        void reset(const Individual &solution);
+
+        /**
+         * @return The reference solution
+         */
+        const Individual &getSolution() const;
+
+        /**
+         * @return The score of the reference solution, INFINITY if no facility is open
+         */
+        double getScore() const;
+
+        /**
+         * @return The number of facilities open in the reference solution
+         */
+        size_t getOpenCount() const;
+
+        /**
+         * @param customer Index of a customer
+         * @return The open facility nearest to the customer, none if no facility is open
+         */
+        size_t getNearest(size_t customer) const;
+
+        /**
+         * @param customer Index of a customer
+         * @return The second nearest open facility, none if less than two facilities are open
+         */
+        size_t getSecondNearest(size_t customer) const;
+
+        /**
+         * Score change of opening or closing a facility of the reference solution.
+         * Closing costs a visit of the customers served by the facility, opening a pass
+         * over its distances.
+         * @param facility Index of the facility to flip
+         * @return The score of the solution with the facility flipped, minus getScore()
+         */
+        double getFlipDelta(size_t facility) const;
+
+        /**
+         * Open or close a facility of the reference solution.
+         * Opening costs a pass over the distances of the facility. Closing costs a visit
+         * of the customers whose two nearest facilities change, each searching the open
+         * facilities, plus a pass over the customers. Rounding errors accumulate in the
+         * score until the next reset.
+         * @param facility Index of the facility to flip
+         */
+        void flip(size_t facility);
+
+        /**
+         * @param individual A solution
+         * @return The number of facilities open in only one of the solution and the
+         * reference solution
+         */
+        size_t countDifferences(const Individual &individual) const;
+
+        /**
+         * Score a solution from its differences with the reference solution.
+         * The cost is a pass over the customers per facility opened in the solution,
+         * plus a visit of the customers served by the closed facilities and a pass to
+         * sum the distances. Customers whose two nearest facilities are closed search
+         * every open facility. The score is the one of FacilityLocation::Objective
+         * exactly, as it is summed in the same order. The evaluator is not modified, so
+         * that it can score solutions from several threads.
+         * @param individual A solution
+         * @param instructionSet Instruction set of the pass over the opened rows,
+         * supported by the processor
+         * @return The score of the solution
+         */
+        double evaluate(const Individual &individual,
+                        InstructionSet instructionSet = Kernel::getBestInstructionSet()) const;
+
+    private:
+        /**
+         * @param individual A solution
+         * @param customer Index of a customer
+         * @return The distance of the customer to the nearest facility open in the solution
+         */
+        double getNearestDistance(const Individual &individual, size_t customer) const;
+
+        /**
+         * Search the second nearest facility of a customer among the open facilities.
+         * @param customer Index of a customer whose nearest facility is up to date
+         */
+        void updateSecondNearest(size_t customer);
+
+        /**
+         * Record that a facility serves a customer.
+         * @param customer Index of a customer
+         * @param facility Index of its nearest facility
+         */
+        void attach(size_t customer, size_t facility);
+
+        /**
+         * Forget that the nearest facility of a customer serves it.
+         * @param customer Index of a customer
+         */
+        void detach(size_t customer);
+
+        const Instance<NF> &instance; /**< The instance */
+        Individual solution; /**< The reference solution */
+        double score; /**< Score of the reference solution */
+        size_t openCount; /**< Number of facilities open in solution */
+
+        std::vector<size_t> nearest; /**< Nearest open facility of each customer */
+        std::vector<size_t> secondNearest; /**< Second nearest open facility of each customer */
+        std::vector<double> nearestDistance; /**< Distance of each customer to nearest */
+        std::vector<double> secondDistance; /**< Distance of each customer to secondNearest */
+
+        std::vector<std::vector<size_t>> served; /**< Customers whose nearest facility is each facility */
+        std::vector<size_t> servedPosition; /**< Position of each customer in the list of its nearest facility */
+
+    };
+
+}
+
+#include "FacilityLocation/IncrementalEvaluator.tpp"
+
+#endif //FACILITYLOCATION_INCREMENTALEVALUATOR_H
@@ -2,30 +2,83 @@
 #define FACILITYLOCATION_INSTANCE_H
 
 #include <algorithm> // swap
+#include <cstdint>
 #include <cstdlib> // size_t
 #include <fstream>
 #include <random>
+#include <vector>
 
 namespace FacilityLocation {
 
+    /**
+     * Order of the distances in the memory of an instance.
+     */
+    enum class Layout {
+        FacilityMajor, /**< Distances of a facility to every customer are contiguous */
+        CustomerMajor, /**< Distances of a customer to every facility are contiguous */
+        Blocked /**< Customers are split in blocks, stored one after the other facility-major */
+    };
+
+    /**
+     * Storage precision of the distances and opening costs of an instance.
+     * Scores are always accumulated in double. Rounding is monotonic, so that the
+     * nearest open facility of a customer keeps its distance rounded, and the error of
+     * a score is at most the sum of the errors of the values it adds:
+     * Double has no error, Float at most 2^-24 times the score, and Fixed16 at most
+     * half a step per customer and per open facility, that is
+     * (numberCustomer * maxDistance + openCount * maxCost) / 131070.
+     * Instance::getErrorBound computes these bounds. Two scores closer than the sum of
+     * their bounds may be ranked in the wrong order.
+     */
+    enum class Precision {
+        Double, /**< 8 bytes per distance, exact */
+        Float, /**< 4 bytes per distance, relative error at most 2^-24 */
+        Fixed16 /**< 2 bytes per distance, multiples of maxDistance / 65535 */
+    };
+
     /**
      * An instance of a Facility Location Problem.
      * This only represent an static instance of the problem.
      * Static functions can be called to generate a new instance
      * <p>
-     * The template NF fix the number of facilities.
+     * The template NF fix the number of facilities, NF = 0 letting it be chosen at
+     * runtime: generators then take the number of facilities as last parameter, and
+     * load(std::string) accepts any number of facilities.
+     * <p>
+     * Distances are stored in a single allocation aligned on a cache line, or on a huge
+     * page when large enough, with facility-major layout after generation or loading.
+     * Rows of every layout start on a cache line, padding included. Kernels that need
+     * another layout call setLayout, and the ones reading less bytes setPrecision.
+     * <p>
+     * Instances are saved as text by save, or in a binary format by saveBinary. A
+     * binary file is a header of 4 KiB, then the distances as stored in memory, padding
+     * included, then the opening costs as doubles, all in the byte order of the
+     * machine. The header is made of 64-bit words: magic, version, number of
+     * facilities, number of customers, precision, layout, block size, distance step,
+     * cost step, checksum of the distances and opening costs, and checksum of the
+     * previous words. load maps binary files in memory and uses them as the storage of
+     * the distances, so that its duration does not depend on the size of the instance.
      */
     template<size_t NF>
     class Instance {
 
     public:
-        constexpr static size_t numberFacility = NF;
-        const size_t numberCustomer;
-
-        static Instance randomInstance(size_t numberCustomer, unsigned int seed = std::random_device()());
-        static Instance randomMetricInstance(size_t numberCustomer, unsigned int seed = std::random_device()(), bool ordered = false);
-        static Instance randomFlawedMetricInstance(size_t numberCustomer, unsigned int seed = std::random_device()(), bool ordered = false);
-        static Instance load(std::string filename);
+        static Instance randomInstance(size_t numberCustomer, unsigned int seed = std::random_device()(),
+                                       size_t numberFacility = NF);
+        static Instance randomMetricInstance(size_t numberCustomer, unsigned int seed = std::random_device()(),
+                                             bool ordered = false, size_t numberFacility = NF);
+        static Instance randomFlawedMetricInstance(size_t numberCustomer, unsigned int seed = std::random_device()(),
+                                                   bool ordered = false, size_t numberFacility = NF);
+        /**
+         * Load an instance saved by save or saveBinary, recognized by its first word.
+         * The distances of a binary file are mapped read-only, and only read when used.
+         * @param filename Path of the file
+         * @param verify true to check the checksum of the distances of a binary file,
+         * which reads all of them
+         * @return The instance, with the layout and precision of the file
+         * @throws std::runtime_error if the file can not be read or is not a valid instance
+         */
+        static Instance load(std::string filename, bool verify = false);
 
         static std::vector<std::pair<double, double>> orderPositions(std::vector<std::pair<double, double>> input);
 
@@ -44,13 +97,239 @@ namespace FacilityLocation {
         double distance(size_t facility, size_t customer) const;
         double cost(size_t facility) const;
 
+        /**
+         * @return The layout of the distances
+         */
+        Layout getLayout() const;
+
+        /**
+         * Move the distances to another layout, with a pass over the distances.
+         * @param layout The new layout
+         * @param blockSize Number of customers of a block of the blocked layout, a
+         * multiple of 32, or 0 for getDefaultBlockSize(getNumberFacility()), lowered to
+         * the number of customers rounded up to 32
+         */
+        void setLayout(Layout layout, size_t blockSize = 0);
+
+        /**
+         * @return The number of customers of a block: all of them for the facility-major
+         * layout, 1 for the customer-major layout
+         */
+        size_t getBlockSize() const;
+
+        /**
+         * @return The storage precision of the distances and opening costs
+         */
+        Precision getPrecision() const;
+
+        /**
+         * Round the distances and opening costs to another precision, with a pass over
+         * the distances. Values rounded once stay rounded when going back to a higher
+         * precision.
+         * @param precision The new precision
+         */
+        void setPrecision(Precision precision);
+
+        /**
+         * @return The difference between consecutive distances of the Fixed16 precision,
+         * 0 for the other precisions
+         */
+        double getDistanceStep() const;
+
+        /**
+         * Maximal difference between a score computed from the stored values and the one
+         * computed from the original distances and opening costs, see Precision.
+         * @param score The score
+         * @param openCount The number of facilities open in the scored solution
+         * @return The bound of the absolute error of the score
+         */
+        double getErrorBound(double score, size_t openCount) const;
+
+        /**
+         * Number of customers of a block of the blocked layout whose distances take
+         * about 256 KiB, to stay in the L2 cache. It is a multiple of 32.
+         * @param numberFacility The number of facilities
+         * @return The number of customers of a block
+         */
+        static constexpr size_t getDefaultBlockSize(size_t numberFacility) {
+            return (numberFacility * 64 > (1u << 15)) ? 64 : ((1u << 15) / numberFacility) & ~size_t(31);
+        }
+
+        /**
+         * Distances of a facility to consecutive customers, up to the end of the block
+         * of the customer. With the facility-major layout, this is the whole row for
+         * customer 0, and with the blocked layout the row of the block.
+         * @tparam Distance The type of the stored distances: double, float, or uint16_t
+         * to be multiplied by getDistanceStep()
+         * @param facility Index of a facility
+         * @param customer Index of the first customer, the first of a block to be aligned
+         * @return Pointer to the distance of the facility to the customer
+         */
+        template<class Distance = double>
+        const Distance *getDistanceRow(size_t facility, size_t customer = 0) const;
+
+        /**
+         * Distances of a customer to every facility, contiguous with the customer-major
+         * layout only.
+         * @tparam Distance The type of the stored distances
+         * @param customer Index of a customer
+         * @return Pointer to getNumberFacility() distances
+         */
+        template<class Distance = double>
+        const Distance *getDistanceColumn(size_t customer) const;
+
+        /**
+         * Build, for each customer, the list of its nearest facilities, sorted by
+         * distance then by index, so that the nearest open facility of a solution is the
+         * first open facility of the list, when one is. The lists are moved by
+         * setLayout, rebuilt by setPrecision, and not saved.
+         * @param candidateCount Length of the lists, reduced to getNumberFacility(), 0
+         * to remove them
+         */
+        void setCandidateCount(size_t candidateCount);
+
+        /**
+         * @return The length of the lists of nearest facilities, 0 if there are none
+         */
+        size_t getCandidateCount() const;
+
+        /**
+         * @param customer Index of a customer
+         * @return Its getCandidateCount() nearest facilities, nearest first
+         */
+        const uint32_t *getCandidates(size_t customer) const;
+
+        /**
+         * @param customer Index of a customer
+         * @return The distances to its nearest facilities, as returned by distance
+         */
+        const double *getCandidateDistances(size_t customer) const;
+
         void save(std::string filename) const;
 
+        /**
+         * Save the instance in the binary format, with its layout and precision.
+         * @param filename Path of the file
+         * @return false if the file can not be written
+         */
+        bool saveBinary(const std::string &filename) const;
+
+        /**
+         * @return true if the distances are mapped from a binary file
+         */
+        bool isMapped() const;
+
+        static constexpr uint64_t magic = 0x54534e494c464147; /**< First word of a binary file, "GAFLINST" */
+        static constexpr uint64_t version = 1; /**< Version of the binary format, second word of a binary file */
+
     private:
-        Instance(size_t numberCustomer);
+        static constexpr size_t headerSize = 4096; /**< Bytes before the distances in a binary file */
+
+        /**
+         * Allocate the distances, zeroed, and the opening costs, left uninitialized.
+         * @param numberFacility The number of facilities, NF unless NF is 0
+         * @param numberCustomer The number of customers
+         * @param layout The layout of the distances
+         * @param blockSize Number of customers of a block with the blocked layout
+         * @param precision The precision of the distances
+         * @param mapping A mapped binary file holding the distances, owned by the
+         * instance, and unmapped if the construction throws, or nullptr to allocate them
+         * @param mappingSize Size of the mapping in bytes
+         */
+        Instance(size_t numberFacility, size_t numberCustomer, Layout layout = Layout::FacilityMajor,
+                 size_t blockSize = 0, Precision precision = Precision::Double, void *mapping = nullptr,
+                 size_t mappingSize = 0);
+
+        /**
+         * Set blockSize, rowStride, blockStride and distanceCount from the sizes, the
+         * layout and the precision.
+         * @param blockSize Number of customers of a block with the blocked layout, 0
+         * for the default one
+         */
+        void setShape(size_t blockSize);
+
+        /**
+         * @return The number of bytes of a stored distance
+         */
+        size_t getDistanceSize() const;
+
+        /**
+         * @param filename Path of a text file written by save
+         * @return The instance
+         * @throws std::runtime_error if the file is not a valid instance
+         */
+        static Instance loadText(const std::string &filename);
+
+        /**
+         * @param filename Path of a binary file written by saveBinary
+         * @param verify true to check the checksum of the distances
+         * @return The instance, whose distances are mapped from the file
+         * @throws std::runtime_error if the file is not a valid instance
+         */
+        static Instance loadBinary(const std::string &filename, bool verify);
+
+        /**
+         * Hash of 64-bit words, to detect corrupted files.
+         * @param data The words
+         * @param size The number of bytes, a multiple of 8
+         * @param hash The hash of the previous words, to chain calls
+         * @return The hash of the previous words and the given ones
+         */
+        static uint64_t checksum(const void *data, size_t size, uint64_t hash = 0xcbf29ce484222325);
+
+        /**
+         * @return The checksum of the distances and opening costs
+         */
+        uint64_t getDataChecksum() const;
+
+        /**
+         * Round a distance to the precision and store it.
+         * @param index Index of the distance, see getIndex
+         * @param value The distance, non-negative and at most the maximal distance with
+         * the Fixed16 precision
+         */
+        void setDistance(size_t index, double value);
+
+        /**
+         * Copy the distances and opening costs of an instance of the same size, rounded
+         * to the precision of this one.
+         * @param instance The instance to copy
+         */
+        void copyValues(const Instance &instance);
+
+        /**
+         * @param facility Index of a facility
+         * @param customer Index of a customer
+         * @return Index of their distance in distances
+         */
+        size_t getIndex(size_t facility, size_t customer) const;
+
+        /**
+         * Allocate aligned memory, on a huge page boundary and advised to use huge pages
+         * when it spans several of them.
+         * @param size The number of bytes
+         * @return The memory, to free with std::free
+         * @throws std::bad_alloc if the memory is exhausted
+         */
+        static void *allocate(size_t size);
 
-        double *distances[NF];
-        double openingCost[NF];
+        size_t numberFacility; /**< Number of facilities, NF unless NF is 0 */
+        size_t numberCustomer; /**< Number of customers */
+        Layout layout; /**< Order of distances */
+        size_t blockSize; /**< Number of customers of a block */
+        size_t rowStride; /**< Offset between the distances of consecutive facilities in a block */
+        size_t blockStride; /**< Offset between consecutive blocks */
+        size_t distanceCount; /**< Number of distances stored, padding included */
+        Precision precision; /**< Type of the stored distances */
+        double distanceStep; /**< Unit of the Fixed16 distances */
+        double costStep; /**< Unit of the Fixed16 opening costs */
+        void *distances; /**< Distances, in the order given by layout */
+        void *mapping; /**< The mapped binary file holding distances, nullptr if allocated */
+        size_t mappingSize; /**< Size of mapping in bytes */
+        double *openingCost; /**< Opening cost of each facility, rounded to the precision */
+        size_t candidateCount; /**< Length of the lists of nearest facilities */
+        std::vector<uint32_t> candidates; /**< Nearest facilities of each customer, one list after the other */
+        std::vector<double> candidateDistances; /**< Distances to the facilities of candidates */
     };
 
     template<size_t NF>
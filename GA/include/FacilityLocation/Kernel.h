@@ -0,0 +1,100 @@
+#ifndef FACILITYLOCATION_KERNEL_H
+#define FACILITYLOCATION_KERNEL_H
+
+#include <cstdint>
+#include <cstdlib> // size_t
+
+namespace FacilityLocation {
+
+    /**
+     * Instruction sets of the kernels.
+     */
+    enum class InstructionSet {
+        Scalar, /**< Portable C++, left to the auto-vectorization of the compiler */
+        AVX2, /**< 32 bytes per instruction */
+        AVX512 /**< 64 bytes per instruction, with the AVX-512 F and BW extensions */
+    };
+
+    /**
+     * Vectorized kernels of the facility location objective.
+     * Each kernel exists for every instruction set, and for distances stored as double,
+     * float or uint16_t, see Precision. The instruction set is chosen once, at the first
+     * call, among the ones supported by the processor, and can be forced per call for
+     * benchmarks. Kernels compute the same results, to the bit, whatever the
+     * instruction set.
+     * <p>
+     * Vector kernels are only compiled on x86, other architectures use the scalar one.
+     */
+    class Kernel final {
+
+    public:
+        Kernel() = delete;
+
+        /**
+         * @param instructionSet An instruction set
+         * @return true if the processor and the build support the instruction set
+         */
+        static bool isSupported(InstructionSet instructionSet);
+
+        /**
+         * @return The fastest instruction set supported by the processor
+         */
+        static InstructionSet getBestInstructionSet();
+
+        /**
+         * @param instructionSet An instruction set
+         * @return Its name, as used by the benchmarks
+         */
+        static const char *getName(InstructionSet instructionSet);
+
+        /**
+         * Lower each minimum to the smallest distance of a row, in place:
+         * minimums[c] = min(minimums[c], rows[0][c], ..., rows[rowCount-1][c]).
+         * A minimum is only replaced by a strictly lower distance, so that the result
+         * does not depend on the order of the rows nor on the instruction set.
+         * @tparam Distance double, float or uint16_t
+         * @param rows Pointers to the rows of distances, from the first customer
+         * @param rowCount The number of rows
+         * @param length The number of customers
+         * @param minimums Array of length minimums to lower
+         */
+        template<class Distance>
+        static void minimum(const Distance *const *rows, size_t rowCount, size_t length, Distance *minimums);
+
+        /**
+         * Same as minimum(const Distance *const*, size_t, size_t, Distance*), with a given
+         * instruction set.
+         * @tparam Distance double, float or uint16_t
+         * @param instructionSet A supported instruction set
+         * @param rows Pointers to the rows of distances, from the first customer
+         * @param rowCount The number of rows
+         * @param length The number of customers
+         * @param minimums Array of length minimums to lower
+         */
+        template<class Distance>
+        static void minimum(InstructionSet instructionSet, const Distance *const *rows, size_t rowCount,
+                            size_t length, Distance *minimums);
+
+    private:
+        /**
+         * Vector operations of an instruction set on a type of distance.
+         */
+        template<class Distance>
+        struct AVX2;
+        template<class Distance>
+        struct AVX512;
+
+        template<class Distance>
+        static void minimumScalar(const Distance *const *rows, size_t rowCount, size_t length, Distance *minimums);
+        template<class Distance>
+        static void minimumAVX2(const Distance *const *rows, size_t rowCount, size_t length, Distance *minimums);
+        template<class Distance>
+        static void minimumAVX512(const Distance *const *rows, size_t rowCount, size_t length, Distance *minimums);
+
+    };
+
+}
+
+#include "FacilityLocation/Kernel.tpp"
+
+#endif //FACILITYLOCATION_KERNEL_H
@@ -2,8 +2,11 @@
 #define FACILITYLOCATION_OBJECTIVE_H
 
 #include <bitset>
+#include <vector>
 #include "GA/Objective.h"
+#include "FacilityLocation/IncrementalEvaluator.h"
 #include "FacilityLocation/Instance.h"
+#include "FacilityLocation/Kernel.h"
 #include "GA/Representation/BinaryRepresentation.h"
 
 namespace FacilityLocation {
@@ -11,6 +14,13 @@ namespace FacilityLocation {
     template<class Individual>
     class Objective;
 
+    /**
+     * Cost of the facilities opened by an individual, plus the distance of each customer
+     * to its nearest open facility.
+     * With N = 0, the number of facilities is the one of the instance, and individuals
+     * must have as many bits.
+     * @tparam N Number of facilities, 0 if chosen at runtime
+     */
     template<size_t N>
     class Objective<GA::BinaryRepresentation<N>> final : public GA::Objective<GA::BinaryRepresentation<N>> {
 
@@ -23,10 +33,133 @@ namespace FacilityLocation {
 
         const Instance<N> &getInstance() const;
 
+        /**
+         * @return The instruction set of the kernels, the best supported one by default
+         */
+        InstructionSet getInstructionSet() const;
+
+        /**
+         * Force the instruction set of the kernels, to compare them. Scores do not depend
+         * on it.
+         * @param instructionSet An instruction set supported by the processor
+         */
+        void setInstructionSet(InstructionSet instructionSet);
+
+        /**
+         * @return The cost of a step of a walk of the lists of nearest facilities, in
+         * passes over a distance
+         * @see setWalkStepCost(double)
+         */
+        double getWalkStepCost() const;
+
+        /**
+         * Set the cost of testing a facility of a list of nearest facilities, in passes
+         * of the reduction over a distance, to choose between walking the lists and
+         * reducing the open rows. Per customer, a walk costs 8 steps plus one per
+         * facility of its list tested, plus 15 per open facility when none of the list
+         * is open, and a reduction one pass per open facility. The default, measured by
+         * the benchmarks, is a pass over 40 bytes of distances with AVX2, 50 with
+         * AVX-512, and over 2 distances without vectors.
+         * @param walkStepCost The cost, or 0 for the default of the instruction set and
+         * of the precision of the instance
+         */
+        void setWalkStepCost(double walkStepCost);
+
         double operator()(const Individual &individual) override;
 
+        /**
+         * Evaluate a batch of individuals tile by tile.
+         * Customers are processed by tiles of about 256 KiB of distances, the blocks of
+         * the blocked layout, and every individual of the batch is scored against a tile
+         * before moving to the next one, so that the distances of a tile are read from
+         * memory once per batch instead of once per individual. The open rows of an
+         * individual are reduced with Kernel::minimum. With the customer-major layout,
+         * customers are scored one by one instead. When the instance has lists of
+         * nearest facilities, see Instance::setCandidateCount, individuals opening
+         * enough facilities for it to be faster find the nearest open facility of a
+         * customer as the first open one of its list instead, and only scan their open
+         * facilities when none of the list is. Scores are identical to the ones of
+         * operator() for every layout. Distances are read in the precision
+         * of the instance and summed in double, see Precision for the error bounds.
+         * @param individuals Array of the individuals to evaluate
+         * @param scores Array receiving the value of each individual
+         * @param count The number of individuals
+         */
+        void evaluate(const Individual *individuals, double *scores, size_t count) override;
+
+        /**
+         * Evaluate children from the changes of the score of their parents.
+         * Children are grouped by parent. With the facility-major layout and the double
+         * precision, an IncrementalEvaluator is built on a parent when its children
+         * differ from it in few enough facilities to repay the cost of about three
+         * evaluations. The other children are evaluated as a single batch.
+         * Scores are exactly the ones of operator(), so that the choice does not
+         * depend on how children are split in batches.
+         * @param children Array of the individuals to evaluate
+         * @param parents Array of pointers to a parent of each child
+         * @param scores Array receiving the value of each child
+         * @param count The number of children
+         * @see IncrementalEvaluator
+         */
+        void evaluateChildren(const Individual *children, const Individual *const *parents, double *scores,
+                              size_t count) override;
+
     private:
+        /**
+         * Add to the scores of individuals the distance of each customer to its nearest
+         * open facility, or set them to INFINITY if no facility is open.
+         * @tparam Distance Type of the distances stored by the instance
+         * @param facilities Open facilities of the individuals, one after the other
+         * @param firstFacility Index in facilities of the first open facility of each
+         * individual, and count + 1 elements
+         * @param scores Array of the scores to increase
+         * @param count The number of individuals
+         */
+        template<class Distance>
+        void addDistances(const std::vector<size_t> &facilities, const std::vector<size_t> &firstFacility,
+                          double *scores, size_t count) const;
+
+        /**
+         * Same as addDistances<Distance>, with the type of the distances of the instance.
+         */
+        void addDistances(const std::vector<size_t> &facilities, const std::vector<size_t> &firstFacility,
+                          double *scores, size_t count) const;
+
+        /**
+         * Same as addDistances for a single individual opening a facility, with its
+         * rows reduced by small tiles on the stack instead of allocated arrays.
+         * @tparam Distance Type of the distances stored by the instance
+         * @param individual The individual
+         * @param score Its score before the distances
+         * @return The score increased by the distances
+         */
+        template<class Distance>
+        double addDistances(const Individual &individual, double score) const;
+
+        /**
+         * @param openCount The number of facilities opened by an individual, not 0
+         * @return true if addCandidateDistances is expected to score the individual
+         * faster than addDistances
+         */
+        bool isWalkFaster(size_t openCount) const;
+
+        /**
+         * Same as addDistances for individuals opening a facility, walking the lists of
+         * nearest facilities of the instance customer by customer, for every individual.
+         * @param individuals Array of the individuals
+         * @param walked Indices of the individuals to score
+         * @param facilities Open facilities of the individuals, one after the other
+         * @param firstFacility Index in facilities of the first open facility of each
+         * individual, and one more element
+         * @param scores Array of the scores to increase
+         */
+        void addCandidateDistances(const Individual *individuals, const std::vector<size_t> &walked,
+                                   const std::vector<size_t> &facilities, const std::vector<size_t> &firstFacility,
+                                   double *scores) const;
+
         const Instance<N> &instance;
+        InstructionSet instructionSet; /**< Instruction set of the kernels */
+        double walkStepCost; /**< Cost of a step of a walk in passes, 0 for the default */
 
     };
 
@@ -1,7 +1,9 @@
 #ifndef GENETICALGORITHM_SOLVER_H
 #define GENETICALGORITHM_SOLVER_H
 
+#include <cstdint>
 #include "Objective.h"
+#include "GA/ThreadPool.h"
 
 namespace FacilityLocation {
 
@@ -9,11 +11,94 @@ namespace FacilityLocation {
     class Solver {
 
     public:
-        static double bruteForce(Instance<NF> &instance, Objective<GA::BinaryRepresentation<NF>> &objective);
-        static double greedy(Instance<NF> &instance);
+        /**
+         * Open facilities and their score.
+         */
+        struct Solution {
+            GA::BinaryRepresentation<NF> individual; /**< Bit i set if facility i is open */
+            double score; /**< Value of the individual for Objective */
+        };
+
+        /**
+         * Optimal solution, found by scoring every set of open facilities.
+         * <p>
+         * Sets are walked in the order of a Gray code, so that consecutive sets differ by
+         * one facility. The distance of each customer to its nearest open facility
+         * among facilities j and above is kept for every j, and when facility i changes,
+         * only these distances for j <= i are updated, from the ones of j + 1. This costs
+         * about one pass over the customers per set, instead of one per open facility.
+         * The sets are split in 64 tasks by their last facilities, run on the thread pool.
+         * The result does not depend on the number of threads.
+         * @param instance An instance of less than 64 facilities, in practice about 40
+         * at most
+         * @param threadPool Pool running the tasks, nullptr to stay on the calling thread
+         * @return The open facilities of an optimal solution, the first one found in
+         * the order of the tasks if several, and their score
+         */
+        static Solution bruteForce(const Instance<NF> &instance, GA::ThreadPool *threadPool = nullptr);
+
+        /**
+         * Greedy algorithm of K. Jain, M. Mahdian and A. Saberi, "A new greedy approach
+         * for facility location problems", within 1.61 times the optimum on metric
+         * instances.
+         * <p>
+         * The budget of every unconnected customer grows with the time. A customer
+         * offers to a facility the excess of its budget over its distance to it, or,
+         * once connected, what it would save by moving to it. A customer connects to
+         * an open facility when its budget reaches its distance, and a facility opens
+         * when the offers reach its opening cost, taking the customers that offer to
+         * it. Instead of raising budgets by small steps, time jumps from one event to
+         * the next: the next distance of a customer, taken from its facilities sorted
+         * by distance, or the next opening time of a facility, kept in a priority
+         * queue. This costs O(F C log C), plus O(F) each time a customer moves to a
+         * nearer facility, and much less when customers connect to facilities near them.
+         * @param instance The instance
+         * @param threadPool Pool sorting the facilities of the customers in parallel,
+         * nullptr to stay on the calling thread
+         * @return The open facilities, ready to seed a population, and their score
+         */
+        static Solution greedy(const Instance<NF> &instance, GA::ThreadPool *threadPool = nullptr);
 
     private:
-        static bool containsFalse(const bool *array, size_t size);
+        /**
+         * Score every set of open facilities among the first ones, the other ones being
+         * given.
+         * @param distances Distances of every facility to every customer, facility by
+         * facility
+         * @param costs Opening cost of every facility
+         * @param numberCustomer The number of customers
+         * @param freeCount The number of first facilities to open or not, less than 64
+         * @param fixed Bit i set if facility freeCount + i is open
+         * @param bestSet Receives bit i set if facility i is open in the best solution
+         * @return The score of the best solution, INFINITY if no facility is open
+         */
+        static double searchSets(const std::vector<double> &distances, const std::vector<double> &costs,
+                                 size_t numberCustomer, size_t freeCount, uint64_t fixed, uint64_t &bestSet);
+
+        /**
+         * Facility of a customer, ordered by distance then by index.
+         */
+        struct Edge {
+            double distance; /**< Distance between the facility and the customer */
+            uint32_t facility; /**< Index of the facility */
+
+            bool operator<(const Edge &edge) const {
+                return distance < edge.distance || (!(edge.distance < distance) && facility < edge.facility);
+            }
+        };
+
+        /**
+         * Replace the sorted edges of a customer by its next ones.
+         * @param instance The instance
+         * @param customer Index of the customer
+         * @param last The last edge of the customer returned, or an edge lower than
+         * any other
+         * @param edges Array of edgeCount edges receiving the next edges of the customer,
+         * followed by an edge of infinite distance if there are less of them
+         * @param edgeCount Number of edges to find
+         */
+        static void sortEdges(const Instance<NF> &instance, size_t customer, const Edge &last, Edge *edges,
+                              size_t edgeCount);
     };
 
 }
@@ -0,0 +1,60 @@
+#ifndef GENETICALGORITHM_ALIASTABLE_H
+#define GENETICALGORITHM_ALIASTABLE_H
+
+#include <cstdlib> // size_t
+#include <vector>
+
+namespace GA {
+
+    /**
+     * A discrete distribution over {0, ..., n-1} sampled in constant time with the
+     * alias method (Vose's variant).
+     * Building the table from n weights costs O(n), and memory is kept between two
+     * builds of the same size.
+     */
+    class AliasTable final {
+
+    public:
+        AliasTable() = default;
+        AliasTable(const AliasTable&) = default;
+        AliasTable(AliasTable&&) = default;
+        ~AliasTable() = default;
+
+        AliasTable &operator=(const AliasTable&) = default;
+        AliasTable &operator=(AliasTable&&) = default;
+
+        /**
+         * Build the table after a list of weights.
+         * Weights must be non-negative. If they are all null, the distribution is uniform.
+         * @param weights The weight of each value, at least one
+         */
+        void build(const std::vector<double> &weights);
+
+        /**
+         * @return The number of values of the distribution
+         */
+        size_t size() const;
+
+        /**
+         * Draw a value with a single uniform number.
+         * @tparam RandomEngine Type of the random engine
+         * @param rnd The random engine
+         * @return A value in {0, ..., size()-1}
+         */
+        template<class RandomEngine>
+        size_t operator()(RandomEngine &rnd) const;
+
+    private:
+        std::vector<double> probability; /**< Probability to keep the drawn column */
+        std::vector<size_t> alias; /**< Value used when the drawn column is not kept */
+
+        std::vector<size_t> small; /**< Buffer of underfull columns used while building */
+        std::vector<size_t> large; /**< Buffer of overfull columns used while building */
+
+    };
+
+}
+
+#include "GA/AliasTable.tpp"
+
+#endif //GENETICALGORITHM_ALIASTABLE_H
@@ -3,6 +3,7 @@
 
 #include <type_traits> // is_base_of
 
+#include "GA/Random.h"
 #include "GA/Representation.h"
 
 namespace GA {
@@ -10,7 +11,8 @@ namespace GA {
     /**
      * Interface of a crossover functor that can be bound to a GA::Engine.
      * The functor must implement an operator() which mix two individuals to create
-     * a new one.
+     * a new one. The functor holds no random state: it draws from the random engine
+     * given by the caller, so that a functor can be shared between engines.
      * @tparam Individual Type of individuals, must be a subclass of Representation
      */
     template<class Individual>
@@ -31,9 +33,11 @@ namespace GA {
          * Generate a new individual based on two given ones.
          * @param individual1 First individual
          * @param individual2 Second individual
+         * @param rnd The random engine to draw from
          * @return A new individual
          */
-        virtual Individual operator()(const Individual &individual1, const Individual &individual2) = 0;
+        virtual Individual operator()(const Individual &individual1, const Individual &individual2,
+                                      RandomEngine &rnd) = 0;
 
     };
 
@@ -16,7 +16,7 @@ namespace GA {
     class MultiPointCrossover;
 
     template<size_t N>
-    class MultiPointCrossover<BinaryRepresentation<N>> : public Crossover<BinaryRepresentation<N>> {
+    class MultiPointCrossover<BinaryRepresentation<N>> final : public Crossover<BinaryRepresentation<N>> {
 
     public:
         const unsigned int numberPoint;
@@ -32,10 +32,8 @@ namespace GA {
         MultiPointCrossover &operator=(MultiPointCrossover&&) = default;
 
         BinaryRepresentation<N>
-        operator()(const BinaryRepresentation<N> &individual1, const BinaryRepresentation<N> &individual2) override;
-
-    private:
-        std::default_random_engine rnd;
+        operator()(const BinaryRepresentation<N> &individual1, const BinaryRepresentation<N> &individual2,
+                   RandomEngine &rnd) override;
 
     };
 
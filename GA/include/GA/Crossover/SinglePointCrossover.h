@@ -16,10 +16,10 @@ namespace GA {
     class SinglePointCrossover;
 
     template<size_t N>
-    class SinglePointCrossover<BinaryRepresentation<N>> : public Crossover<BinaryRepresentation<N>> {
+    class SinglePointCrossover<BinaryRepresentation<N>> final : public Crossover<BinaryRepresentation<N>> {
 
     public:
-        SinglePointCrossover();
+        SinglePointCrossover() = default;
         SinglePointCrossover(const SinglePointCrossover&) = default;
         SinglePointCrossover(SinglePointCrossover&&) = default;
         virtual ~SinglePointCrossover() = default;
@@ -28,10 +28,8 @@ namespace GA {
         SinglePointCrossover &operator=(SinglePointCrossover&&) = default;
 
         BinaryRepresentation<N>
-        operator()(const BinaryRepresentation<N> &individual1, const BinaryRepresentation<N> &individual2) override;
-
-    private:
-        std::default_random_engine rnd;
+        operator()(const BinaryRepresentation<N> &individual1, const BinaryRepresentation<N> &individual2,
+                   RandomEngine &rnd) override;
 
     };
 
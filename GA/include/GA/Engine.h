@@ -2,43 +2,84 @@
 #define GENETICALGORITHM_ENGINE_H
 
 #include <type_traits> // is_base_of
+#include <cstdint> // uint64_t
+#include <memory> // unique_ptr
+#include <utility> // pair
 #include <random>
-
-#include <map>
+#include <string>
+#include <vector>
 
 #include "GA/Crossover.h"
 #include "GA/Mutation.h"
 #include "GA/Objective.h"
+#include "GA/ParentSampling.h"
+#include "GA/Population.h"
+#include "GA/Profile.h"
+#include "GA/Random.h"
 #include "GA/Representation.h"
 #include "GA/Selection.h"
+#include "GA/Termination.h"
+#include "GA/ThreadPool.h"
 
+#include "GA/ParentSampling/LinearRankSampling.h"
 #include "GA/Representation/BinaryRepresentation.h"
 
 namespace GA {
 
     /**
      * This class is the core of genetic algorithms.
+     * <p>
+     * By default, the functors are bound through their abstract interfaces and can be
+     * any subclass, chosen at runtime. The types of the functors can also be fixed at
+     * compile time, see StaticEngine: if these types are final, every call to a
+     * functor is resolved statically and can be inlined in the generation loop.
      * @tparam Individual Type of individuals, must be a subclass of Representation
+     * @tparam ObjectiveT Type of the objective functor, a subclass of Objective
+     * @tparam CrossoverT Type of the crossover functor, a subclass of Crossover
+     * @tparam MutationT Type of the mutation functor, a subclass of Mutation
+     * @tparam SelectionT Type of the selection functor, a subclass of Selection
      */
-    template<class Individual>
+    template<class Individual,
+             class ObjectiveT = Objective<Individual>,
+             class CrossoverT = Crossover<Individual>,
+             class MutationT = Mutation<Individual>,
+             class SelectionT = Selection<Individual>>
     class Engine final {
         static_assert(std::is_base_of<Representation, Individual>::value,
                       "Individual not derived from Representation");
+        static_assert(std::is_base_of<Objective<Individual>, ObjectiveT>::value,
+                      "ObjectiveT not derived from Objective");
+        static_assert(std::is_base_of<Crossover<Individual>, CrossoverT>::value,
+                      "CrossoverT not derived from Crossover");
+        static_assert(std::is_base_of<Mutation<Individual>, MutationT>::value,
+                      "MutationT not derived from Mutation");
+        static_assert(std::is_base_of<Selection<Individual>, SelectionT>::value,
+                      "SelectionT not derived from Selection");
 
-    private:
+    public:
         /**
          * A population, or a set of individuals.
-         * To simplify algorithms, the sorting of best individuals is managed by the
-         * container during insertion.
-         *
-         * The required properties of the container are:
-         * <ul>
-         * <li>Contains pairs of Individual and double
-         * <li>Can contain multiple identical pair
-         * <li>Ordered after the values of doubles
-         * </ul>
-         */
-        using Population = std::multimap<double, Individual>;
+         * The population of the engine is kept sorted after the scores between two
+         * steps, so that the best individuals are always the first ones.
+         * @see GA::Population
+         */
+        using Population = GA::Population<Individual>;
+
+        /**
+         * The way new individuals enter the population.
+         */
+        enum class Replacement {
+            /**
+             * Each step builds a new population from the output of the selection
+             * functor, completed with new individuals.
+             */
+            Generational,
+            /**
+             * Each step creates a few new individuals which take the place of the worst
+             * ones, in place. The selection functor is not used.
+             */
+            SteadyState
+        };
 
     public:
         Engine() = delete;
@@ -63,10 +104,10 @@ namespace GA {
          * @see Mutation
          * @see Selection
          */
-        Engine(Objective<Individual> &objective,
-               Crossover<Individual> &crossover,
-               Mutation<Individual> &mutation,
-               Selection<Individual> &selection);
+        Engine(ObjectiveT &objective,
+               CrossoverT &crossover,
+               MutationT &mutation,
+               SelectionT &selection);
 
         /**
          * Default destructor
@@ -77,25 +118,31 @@ namespace GA {
          * @return The objective functor bound to the engine
          * @see setObjective(Objective&)
          */
-        Objective<Individual> &getObjective() const;
+        ObjectiveT &getObjective() const;
 
         /**
          * @return The crossover functor bound to the engine
          * @see setCrossover(Crossover&)
          */
-        Crossover<Individual> &getCrossover() const;
+        CrossoverT &getCrossover() const;
 
         /**
          * @return The mutation functor bound to the engine
          * @see setMutation(Mutation&)
          */
-        Mutation<Individual> &getMutation() const;
+        MutationT &getMutation() const;
 
         /**
          * @return The selection functor bound to the engine
          * @see setSelection(Selection&)
          */
-        Selection<Individual> &getSelection() const;
+        SelectionT &getSelection() const;
+
+        /**
+         * @return The parent sampling functor bound to the engine
+         * @see setParentSampling(ParentSampling&)
+         */
+        ParentSampling<Individual> &getParentSampling() const;
 
         /**
          * @return The aimed population size after the next step
@@ -103,33 +150,76 @@ namespace GA {
          */
         size_t getPopulationSize() const;
 
+        /**
+         * @return The way new individuals enter the population
+         * @see setReplacement(Replacement)
+         */
+        Replacement getReplacement() const;
+
+        /**
+         * @return The number of new individuals created by a steady-state step
+         * @see setOffspringCount(size_t)
+         */
+        size_t getOffspringCount() const;
+
+        /**
+         * @return The number of threads used to evaluate new individuals
+         * @see setThreadCount(size_t)
+         * @see setThreadPool(ThreadPool&)
+         */
+        size_t getThreadCount() const;
+
+        /**
+         * @return The individual copied to build the initial population
+         * @see setPrototype(const Individual&)
+         */
+        const Individual &getPrototype() const;
+
+        /**
+         * Seed the random engine of the engine.
+         * Every random draw of a run, functors included, comes from this engine: two
+         * runs with the same seed and the same parameters give the same result,
+         * whatever the number of threads. By default, the engine is seeded from
+         * std::random_device.
+         * @param seed The seed
+         */
+        void setSeed(uint64_t seed);
+
         /**
          * Set a new objective functor
          * @param objective The new functor
          * @see getObjective()
          */
-        void setObjective(Objective<Individual> &objective);
+        void setObjective(ObjectiveT &objective);
 
         /**
          * Set a new crossover functor
          * @param crossover The new functor
          * @see getCrossover()
          */
-        void setCrossover(Crossover<Individual> &crossover);
+        void setCrossover(CrossoverT &crossover);
 
         /**
          * Set a new mutation functor
          * @param mutation The new functor
          * @see getMutation()
          */
-        void setMutation(Mutation<Individual> &mutation);
+        void setMutation(MutationT &mutation);
 
         /**
          * Set a new selection functor
          * @param selection The new functor
          * @see getSelection()
          */
-        void setSelection(Selection<Individual> &selection);
+        void setSelection(SelectionT &selection);
+
+        /**
+         * Set a new parent sampling functor.
+         * By default, parents are drawn with a LinearRankSampling owned by the engine.
+         * @param parentSampling The new functor
+         * @see getParentSampling()
+         */
+        void setParentSampling(ParentSampling<Individual> &parentSampling);
 
         /**
          * Set the size of population to aim after the next step.
@@ -139,11 +229,59 @@ namespace GA {
          */
         void setPopulationSize(size_t populationSize);
 
+        /**
+         * Set the way new individuals enter the population, Replacement::Generational
+         * by default.
+         * @param replacement The new replacement mode
+         * @see getReplacement()
+         */
+        void setReplacement(Replacement replacement);
+
+        /**
+         * Set the number of new individuals created by a steady-state step, 1 by default.
+         * @param offspringCount A strictly positive number of individuals
+         * @see getOffspringCount()
+         * @see Replacement::SteadyState
+         */
+        void setOffspringCount(size_t offspringCount);
+
+        /**
+         * Breed and evaluate new individuals with a pool of threads owned by the engine.
+         * The parent sampling, crossover, mutation and objective functors are then called
+         * concurrently from several threads and must be reentrant. Individuals are bred
+         * by chunks of fixed size, each with its own random engine seeded in the order
+         * of the chunks, and merged in the order of their generation, so the result of
+         * a step does not depend on the number of threads.
+         * A count of 1, the default, evaluates every individual on the calling thread.
+         * @param threadCount The number of threads, calling thread included
+         * @see getThreadCount()
+         */
+        void setThreadCount(size_t threadCount);
+
+        /**
+         * Evaluate new individuals with a pool of threads shared with other engines.
+         * The same requirements as setThreadCount(size_t) apply to the objective.
+         * @param threadPool The pool, for instance ThreadPool::shared()
+         * @see getThreadCount()
+         */
+        void setThreadPool(ThreadPool &threadPool);
+
+        /**
+         * Set the individual copied, then randomized, to build each individual of the
+         * initial population, a default constructed individual by default.
+         * Representations whose size is chosen at runtime, like BinaryRepresentation<0>,
+         * take it from the prototype.
+         * @param prototype The new prototype
+         * @see getPrototype()
+         */
+        void setPrototype(const Individual &prototype);
+
         /**
          * Initialize a basic population composed of random individuals.
          * The size of the population is 1 by default, but can (and should) be modified
          * before the call to this function with setPopulationSize(size_t).
-         * Each individual is generate via the function GA::Representation::randomize()
+         * Each individual is generate via the function randomize(RandomEngine&) of the
+         * representation
          * @see setPopulationSize(size_t)
          * @see initialize(size_t)
          */
@@ -154,7 +292,8 @@ namespace GA {
          * The size of the population is defined by the parameter. Note that this
          * size will be kept after the call, as if setPopulationSize(size_t) had been
          * called.
-         * Each individual is generate via the function GA::Representation::randomize()
+         * Each individual is generate via the function randomize(RandomEngine&) of the
+         * representation
          * @see setPopulationSize(size_t)
          * @see initialize()
          */
@@ -171,6 +310,12 @@ namespace GA {
          * Updates the population after an iteration of the genetic algorithm.
          * The size of the new population can be set with the function
          * setPopulationSize(size_t)
+         * <p>
+         * In generational mode, a step selects survivors with the selection functor
+         * and completes the population with new individuals.
+         * In steady-state mode, a step creates getOffspringCount() new individuals; each
+         * one replaces the worst individual of the population if it is at least as good,
+         * so that an improvement is visible as soon as the step returns.
          * Please refers to the implementation for more details.
          * @param numberStep The number of step
          * @return The score of the best individual generated
@@ -178,6 +323,28 @@ namespace GA {
          */
         double step(unsigned int numberStep);
 
+        /**
+         * Run generations until the termination criteria are met.
+         * The criteria are checked after each generation, and also before the first
+         * one, so that a run whose target score is already reached does no step.
+         * @param termination The budget of the run
+         * @return The bits of the criteria that stopped the run
+         * @see Termination::Criterion
+         */
+        unsigned int run(Termination &termination);
+
+        /**
+         * Run generations until the termination criteria are met, and call a function
+         * after each generation, for instance to trace the run.
+         * @tparam Callback Callable as callback(const Engine&)
+         * @param termination The budget of the run
+         * @param callback The function called after each generation
+         * @return The bits of the criteria that stopped the run
+         * @see Termination::Criterion
+         */
+        template<class Callback>
+        unsigned int run(Termination &termination, Callback callback);
+
         /**
          * @return The score of the best individual of the current population
          */
@@ -214,20 +381,171 @@ namespace GA {
          */
         double getStandardDeviation(size_t count) const;
 
+        /**
+         * @return The number of steps since the last initialization
+         */
+        unsigned long getGeneration() const;
+
+        /**
+         * @return The number of calls to the objective since the last initialization,
+         * the initial population included
+         */
+        unsigned long getEvaluationCount() const;
+
+        /**
+         * @return The counters of the steps since the last call to resetProfile(), empty
+         * unless the engine is compiled with GA_PROFILING
+         * @see Profile
+         */
+        const Profile &getProfile() const;
+
+        /**
+         * Clear the counters of getProfile().
+         */
+        void resetProfile();
+
+        /**
+         * @return The current population, sorted after the scores
+         */
+        const Population &getPopulation() const;
+
+        /**
+         * Copy the best individuals of the population, to send them to another engine.
+         * @param count The number of individuals, at most the size of the population
+         * @return The count best individuals, sorted after the scores
+         * @see immigrate(const Population&)
+         */
+        Population emigrate(size_t count) const;
+
+        /**
+         * Insert already evaluated individuals in the population.
+         * They take the place of the worst individuals: the size of the population
+         * does not change, and immigrants worse than every resident are dropped.
+         * @param immigrants The individuals to insert, with their scores
+         * @see emigrate(size_t)
+         */
+        void immigrate(const Population &immigrants);
+
+        /**
+         * Save the state of the engine in a binary file: the population with its
+         * scores, the population size, the generation and evaluation counters and the
+         * state of the random engine.
+         * The file is first written next to its destination, then renamed, so that an
+         * interruption never leaves a partial checkpoint behind. The cost is a single
+         * copy of the population, cheap enough to be done every few seconds.
+         * The state of the functors is not saved.
+         * Individuals must provide the getWordCount, getWords and setWords members of
+         * BinaryRepresentation, and have the size of the prototype.
+         * @param path Path of the checkpoint file
+         * @return false if the file could not be written
+         * @see loadCheckpoint(const std::string&)
+         */
+        bool saveCheckpoint(const std::string &path) const;
+
+        /**
+         * Restore a state saved by saveCheckpoint(const std::string&).
+         * The population is restored with its scores, without any call to the
+         * objective. Checkpoints are written in the byte order of the machine and
+         * only readable by an engine with the same type of individual. Individuals
+         * are restored as copies of the prototype.
+         * @param path Path of the checkpoint file
+         * @return false, leaving the engine untouched, if the file could not be read
+         * or is not a valid checkpoint
+         * @see saveCheckpoint(const std::string&)
+         */
+        bool loadCheckpoint(const std::string &path);
+
     private:
-        std::default_random_engine rnd;
+        /**
+         * Run a single generation.
+         */
+        void advance();
+
+        /**
+         * Build the next population in generational mode.
+         */
+        void stepGenerational();
+
+        /**
+         * Insert new individuals in the population in steady-state mode.
+         */
+        void stepSteadyState();
+
+        /**
+         * Fill offspring with new individuals bred from the current population.
+         * Individuals are bred by chunks of breedingChunk, on the thread pool if there
+         * is one, each chunk drawing from a random engine seeded from rnd in the order
+         * of the chunks.
+         * A new individual identical to one of its parents takes the score of the parent,
+         * without any call to the objective. Such individuals are placed at the end
+         * of offspring, after the offspringPending individuals still to evaluate.
+         * The first parent of each of them is recorded in offspringParents.
+         * @param count The number of new individuals
+         */
+        void breedOffspring(size_t count);
+
+        /**
+         * Compute the scores of the offspringPending first individuals of offspring
+         * into offspringScores, with a single batch per thread of the thread pool if
+         * there is one. Batches go through Objective::evaluateChildren, with the parents
+         * of offspringParents, unless offspringParents is empty.
+         */
+        void evaluateOffspring();
+
+        static constexpr size_t breedingChunk = 64; /**< Number of individuals bred from the same random engine */
+        static constexpr uint64_t checkpointMagic = 0x31544b4843414721; /**< "!GACHKT1" in little endian */
+        static constexpr uint64_t checkpointVersion = 3; /**< Version of the checkpoint format */
 
-        Objective<Individual> &objective; /**< Bounded objective functor */
-        Crossover<Individual> &crossover; /**< Bounded crossover functor */
-        Mutation<Individual> &mutation; /**< Bounded mutation functor */
-        Selection<Individual> &selection; /**< Bounded selection functor */
+        RandomEngine rnd; /**< Random engine of the engine and of every functor call */
+
+        ObjectiveT &objective; /**< Bounded objective functor */
+        CrossoverT &crossover; /**< Bounded crossover functor */
+        MutationT &mutation; /**< Bounded mutation functor */
+        SelectionT &selection; /**< Bounded selection functor */
+        ParentSampling<Individual> *parentSampling; /**< Bounded parent sampling functor */
+
+        LinearRankSampling<Individual> defaultParentSampling; /**< Parent sampling used by default */
 
         size_t populationSize; /**< The aimed population size after the next step */
+        Replacement replacement; /**< The way new individuals enter the population */
+        size_t offspringCount; /**< Number of new individuals of a steady-state step */
+        Individual prototype; /**< Copied to build the initial population */
 
         Population population; /**< Current population */
+        Population nextPopulation; /**< Buffer of the next generational population */
+        unsigned long generation; /**< Number of steps since the last initialization */
+        unsigned long evaluationCount; /**< Number of calls to the objective since the last initialization */
+        Profile profile; /**< Counters of the steps, updated with GA_PROFILING */
+
+        std::unique_ptr<ThreadPool> ownedThreadPool; /**< Pool created by setThreadCount(size_t) */
+        ThreadPool *threadPool; /**< Pool used for evaluations, nullptr to stay on the calling thread */
+
+        std::vector<Individual> offspring; /**< Individuals generated during a step */
+        std::vector<double> offspringScores; /**< Scores of offspring */
+        size_t offspringPending; /**< Number of individuals at the front of offspring to evaluate */
+        std::vector<const Individual *> offspringParents; /**< First parent of each pending individual, in population */
+        std::vector<uint64_t> breedingSeeds; /**< Seed of the random engine of each chunk of offspring */
+        std::vector<Individual> bred; /**< Individuals generated during a step, in the order of generation */
+        std::vector<std::pair<size_t, size_t>> bredParents; /**< Indices in population of the parents of bred */
+        std::vector<Profile> breedingProfiles; /**< Counters of the breeding of each chunk, with GA_PROFILING */
 
     };
 
+    /**
+     * An engine whose functors are of fixed types, known at compile time.
+     * Calls to final functors are dispatched statically, which lets the compiler
+     * inline the crossover, the mutation and the objective in the generation loop.
+     * The engine with abstract functors, Engine<Individual>, stays available when
+     * functors must be chosen at runtime.
+     * @tparam Individual Type of individuals, must be a subclass of Representation
+     * @tparam ObjectiveT Type of the objective functor, a subclass of Objective
+     * @tparam CrossoverT Type of the crossover functor, a subclass of Crossover
+     * @tparam MutationT Type of the mutation functor, a subclass of Mutation
+     * @tparam SelectionT Type of the selection functor, a subclass of Selection
+     */
+    template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+    using StaticEngine = Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>;
+
 }
 
 #include "GA/Engine.tpp"
@@ -0,0 +1,210 @@
+#ifndef GENETICALGORITHM_ISLANDENGINE_H
+#define GENETICALGORITHM_ISLANDENGINE_H
+
+#include <type_traits> // is_base_of
+#include <cstdint> // uint64_t
+#include <memory> // unique_ptr
+#include <random>
+#include <vector>
+
+#include "GA/Crossover.h"
+#include "GA/Engine.h"
+#include "GA/Mutation.h"
+#include "GA/Objective.h"
+#include "GA/Random.h"
+#include "GA/Representation.h"
+#include "GA/Selection.h"
+#include "GA/ThreadPool.h"
+
+namespace GA {
+
+    /**
+     * Island model of genetic algorithms.
+     * Several independent engines, the islands, evolve in parallel, one thread each.
+     * Every few generations, the best individuals of each island migrate to other
+     * islands, following a topology.
+     * @tparam Individual Type of individuals, must be a subclass of Representation
+     */
+    template<class Individual>
+    class IslandEngine final {
+        static_assert(std::is_base_of<Representation, Individual>::value,
+                      "Individual not derived from Representation");
+
+    public:
+        using Population = typename Engine<Individual>::Population;
+
+        /**
+         * The way migrants travel between islands.
+         */
+        enum class Topology {
+            Ring, /**< Island i sends its migrants to island i+1 */
+            FullyConnected, /**< Every island sends its migrants to every other island */
+            Random /**< Every island sends its migrants to another island drawn at random */
+        };
+
+    public:
+        IslandEngine();
+
+        IslandEngine(const IslandEngine &) = delete;
+
+        IslandEngine(IslandEngine &&) = delete;
+
+        IslandEngine &operator=(const IslandEngine &) = delete;
+
+        IslandEngine &operator=(IslandEngine &&) = delete;
+
+        /**
+         * Default destructor
+         */
+        ~IslandEngine() = default;
+
+        /**
+         * Add an island bound to the given functors.
+         * Islands run concurrently. Crossover, mutation and selection functors draw
+         * from the random engine of their island and can be shared between islands.
+         * The objective functor can be shared if it is reentrant, and a parent
+         * sampling functor set on an island must not be shared.
+         * @param objective The objective functor
+         * @param crossover The crossover functor
+         * @param mutation The mutation functor
+         * @param selection The selection functor
+         * @return The engine of the new island, to be further configured if needed
+         */
+        Engine<Individual> &addIsland(Objective<Individual> &objective,
+                                      Crossover<Individual> &crossover,
+                                      Mutation<Individual> &mutation,
+                                      Selection<Individual> &selection);
+
+        /**
+         * @return The number of islands
+         */
+        size_t getNumberIsland() const;
+
+        /**
+         * @param index Index of an island
+         * @return The engine of the island
+         */
+        Engine<Individual> &getIsland(size_t index);
+
+        /**
+         * @param index Index of an island
+         * @return The engine of the island
+         */
+        const Engine<Individual> &getIsland(size_t index) const;
+
+        /**
+         * @return The topology followed by migrants
+         * @see setTopology(Topology)
+         */
+        Topology getTopology() const;
+
+        /**
+         * @return The number of generations between two migrations
+         * @see setMigrationInterval(unsigned int)
+         */
+        unsigned int getMigrationInterval() const;
+
+        /**
+         * @return The number of individuals sent by an island at each migration
+         * @see setMigrationSize(size_t)
+         */
+        size_t getMigrationSize() const;
+
+        /**
+         * Set the topology followed by migrants, Topology::Ring by default.
+         * @param topology The new topology
+         * @see getTopology()
+         */
+        void setTopology(Topology topology);
+
+        /**
+         * Set the number of generations between two migrations, 10 by default.
+         * @param migrationInterval A strictly positive number of generations
+         * @see getMigrationInterval()
+         */
+        void setMigrationInterval(unsigned int migrationInterval);
+
+        /**
+         * Set the number of best individuals sent by an island at each migration,
+         * 1 by default. It can not exceed the size of a population.
+         * @param migrationSize The number of migrants
+         * @see getMigrationSize()
+         */
+        void setMigrationSize(size_t migrationSize);
+
+        /**
+         * Seed the random engine of the island model.
+         * Islands are seeded from it at each initialization, so that a whole run is
+         * determined by this single seed. By default, the engine is seeded from
+         * std::random_device.
+         * @param seed The seed
+         */
+        void setSeed(uint64_t seed);
+
+        /**
+         * Initialize every island with a random population of the given size.
+         * @param populationSize The size of the population of each island
+         * @see Engine::initialize(size_t)
+         */
+        void initialize(size_t populationSize);
+
+        /**
+         * Shortcut of step(1)
+         * @return The score of the best individual over all islands
+         * @see step(unsigned int)
+         */
+        double step();
+
+        /**
+         * Run generations on every island, in parallel, and migrate individuals each
+         * time the number of generations since the initialization reaches a multiple
+         * of the migration interval.
+         * @param numberStep The number of generations
+         * @return The score of the best individual over all islands
+         */
+        double step(unsigned int numberStep);
+
+        /**
+         * @return The score of the best individual over all islands
+         */
+        double getScore() const;
+
+        /**
+         * @return The best individual over all islands
+         */
+        const Individual getBest() const;
+
+        /**
+         * @return The number of generations since the last initialization
+         */
+        unsigned long getGeneration() const;
+
+    private:
+        /**
+         * Exchange the best individuals of the islands along the topology.
+         */
+        void migrate();
+
+        /**
+         * @return The index of the island holding the best individual
+         */
+        size_t getBestIsland() const;
+
+        RandomEngine rnd; /**< Random engine seeding the islands and drawing the Random topology */
+
+        std::vector<std::unique_ptr<Engine<Individual>>> islands; /**< Engines of the islands */
+        std::unique_ptr<ThreadPool> threadPool; /**< One thread per island */
+
+        Topology topology; /**< Topology followed by migrants */
+        unsigned int migrationInterval; /**< Number of generations between two migrations */
+        size_t migrationSize; /**< Number of individuals sent by an island */
+
+        unsigned long generation; /**< Number of generations since the last initialization */
+
+    };
+
+}
+
+#include "GA/IslandEngine.tpp"
+
+#endif //GENETICALGORITHM_ISLANDENGINE_H
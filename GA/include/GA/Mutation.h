@@ -3,6 +3,7 @@
 
 #include <type_traits> // is_base_of
 
+#include "GA/Random.h"
 #include "GA/Representation.h"
 
 namespace GA {
@@ -10,7 +11,8 @@ namespace GA {
     /**
      * Interface of a mutation functor that can be bound to a GA::Engine.
      * The functor must implement an operator() which returns the given individual after
-     * its modification.
+     * its modification. The functor holds no random state: it draws from the random
+     * engine given by the caller, so that a functor can be shared between engines.
      * @tparam Individual Type of individuals, must be a subclass of Representation
      */
     template<class Individual>
@@ -30,15 +32,17 @@ namespace GA {
         /**
          * Modify the individual.
          * @param individual Individual to modify
+         * @param rnd The random engine to draw from
          * @return The modified individual
          */
-        virtual Individual operator()(Individual &individual) = 0;
+        virtual Individual operator()(Individual &individual, RandomEngine &rnd) = 0;
         /**
          * Generate a modified version of an individual
          * @param individual Individual to modify
+         * @param rnd The random engine to draw from
          * @return A new individual
          */
-        virtual Individual operator()(const Individual &individual) = 0;
+        virtual Individual operator()(const Individual &individual, RandomEngine &rnd) = 0;
 
     };
 
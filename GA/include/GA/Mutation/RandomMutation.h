@@ -16,7 +16,7 @@ namespace GA {
     class RandomMutation;
 
     template<size_t N>
-    class RandomMutation<BinaryRepresentation<N>> : public Mutation<BinaryRepresentation<N>> {
+    class RandomMutation<BinaryRepresentation<N>> final : public Mutation<BinaryRepresentation<N>> {
 
     public:
         using Individual = BinaryRepresentation<N>;
@@ -35,12 +35,10 @@ namespace GA {
         double getProbability() const;
         void setProbability(double probability);
 
-        Individual operator()(Individual &individual) override;
-        Individual operator()(const Individual &individual) override;
-
-    protected:
-        std::default_random_engine rnd;
+        Individual operator()(Individual &individual, RandomEngine &rnd) override;
+        Individual operator()(const Individual &individual, RandomEngine &rnd) override;
 
+    private:
         double probability;
 
     };
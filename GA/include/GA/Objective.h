@@ -2,6 +2,7 @@
 #define GENETICALGORITHM_OBJECTIVE_H
 
 #include <type_traits> // is_base_of
+#include <cstdlib> // size_t
 
 #include "GA/Representation.h"
 
@@ -34,11 +35,52 @@ namespace GA {
          */
         virtual double operator()(const Individual &individual) = 0;
 
+        /**
+         * Compute the objective values of several individuals at once.
+         * The engine calls this function once per step with every new individual.
+         * The default implementation calls operator() on each individual; objectives
+         * reading large data should override it to share memory traffic across the
+         * individuals of a batch.
+         * @param individuals Array of the individuals to evaluate
+         * @param scores Array receiving the value of each individual
+         * @param count The number of individuals
+         */
+        virtual void evaluate(const Individual *individuals, double *scores, size_t count);
+
+        /**
+         * Compute the objective values of individuals bred from known parents.
+         * Children usually differ from their parent in a few positions, which lets an
+         * objective score them from the changes of the score of their parent. The engine
+         * calls this function instead of evaluate(const Individual*, double*, size_t) for
+         * every new individual, with its first parent. Children of a same parent are
+         * given the same pointer.
+         * The default implementation ignores the parents and calls evaluate.
+         * @param children Array of the individuals to evaluate
+         * @param parents Array of pointers to a parent of each child
+         * @param scores Array receiving the value of each child
+         * @param count The number of children
+         */
+        virtual void evaluateChildren(const Individual *children, const Individual *const *parents, double *scores,
+                                      size_t count);
+
     };
 
     template<class Individual>
     inline Objective<Individual>::~Objective() {}
 
+    template<class Individual>
+    inline void Objective<Individual>::evaluate(const Individual *individuals, double *scores, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            scores[i] = (*this)(individuals[i]);
+        }
+    }
+
+    template<class Individual>
+    inline void Objective<Individual>::evaluateChildren(const Individual *children, const Individual *const *,
+                                                        double *scores, size_t count) {
+        this->evaluate(children, scores, count);
+    }
+
 }
 
 #endif //GENETICALGORITHM_OBJECTIVE_H
@@ -0,0 +1,141 @@
+#ifndef GENETICALGORITHM_CACHEDOBJECTIVE_H
+#define GENETICALGORITHM_CACHEDOBJECTIVE_H
+
+#include <cstdlib>
+#include <functional> // hash
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "GA/Objective.h"
+
+namespace GA {
+
+    /**
+     * Objective functor remembering the scores of the last evaluated individuals.
+     * The cache is bounded: when it is full, an entry is evicted with the CLOCK policy,
+     * an approximation of LRU which only costs a flag per entry on a hit.
+     * The decorated objective must be deterministic. The cache can be called
+     * concurrently if the decorated objective is reentrant.
+     * @tparam Individual Type of individuals, must be a subclass of Representation
+     * @tparam Hash Hash functor of individuals
+     */
+    template<class Individual, class Hash = std::hash<Individual>>
+    class CachedObjective final : public Objective<Individual> {
+
+    public:
+        CachedObjective() = delete;
+        CachedObjective(const CachedObjective&) = delete;
+        CachedObjective(CachedObjective&&) = delete;
+
+        /**
+         * @param objective The objective functor whose scores are cached
+         * @param capacity The maximal number of individuals remembered
+         */
+        CachedObjective(Objective<Individual> &objective, size_t capacity);
+
+        ~CachedObjective() = default;
+
+        CachedObjective &operator=(const CachedObjective&) = delete;
+        CachedObjective &operator=(CachedObjective&&) = delete;
+
+        double operator()(const Individual &individual) override;
+
+        /**
+         * Answer the individuals found in the cache, and forward the others to the
+         * decorated objective as a single batch.
+         * @param individuals Array of the individuals to evaluate
+         * @param scores Array receiving the value of each individual
+         * @param count The number of individuals
+         */
+        void evaluate(const Individual *individuals, double *scores, size_t count) override;
+
+        /**
+         * Answer the children found in the cache, and forward the others with their
+         * parents to the decorated objective as a single batch.
+         * @param children Array of the individuals to evaluate
+         * @param parents Array of pointers to a parent of each child
+         * @param scores Array receiving the value of each child
+         * @param count The number of children
+         */
+        void evaluateChildren(const Individual *children, const Individual *const *parents, double *scores,
+                              size_t count) override;
+
+        /**
+         * @return The maximal number of individuals remembered
+         */
+        size_t getCapacity() const;
+
+        /**
+         * @return The number of individuals currently remembered
+         */
+        size_t size() const;
+
+        /**
+         * @return The number of evaluations answered by the cache
+         */
+        size_t getHitCount() const;
+
+        /**
+         * @return The number of evaluations forwarded to the decorated objective
+         */
+        size_t getMissCount() const;
+
+        /**
+         * Forget every individual and reset the counters.
+         */
+        void clear();
+
+    private:
+        struct Entry {
+            Individual individual;
+            double score;
+            bool referenced; /**< Set on each hit, cleared when the clock hand passes */
+        };
+
+        /**
+         * Answer the individuals found in the cache, and count the others as misses.
+         * @param individuals Array of the individuals to look up
+         * @param scores Array receiving the value of each individual found
+         * @param count The number of individuals
+         * @return The positions of the individuals not found, in increasing order
+         */
+        std::vector<size_t> lookup(const Individual *individuals, double *scores, size_t count);
+
+        /**
+         * Remember the scores of the individuals not found by lookup.
+         * @param individuals Array of the individuals given to lookup
+         * @param scores Array of their values
+         * @param missPositions The positions returned by lookup
+         * @param missScores The value of each individual not found
+         */
+        void storeMisses(const Individual *individuals, double *scores, const std::vector<size_t> &missPositions,
+                         const std::vector<double> &missScores);
+
+        /**
+         * Remember a score, evicting an entry if the cache is full.
+         * The mutex must be held.
+         * @param individual The evaluated individual
+         * @param score Its score
+         */
+        void store(const Individual &individual, double score);
+
+        Objective<Individual> &objective; /**< Decorated objective */
+        const size_t capacity; /**< Maximal number of entries */
+
+        std::unordered_map<Individual, size_t, Hash> index; /**< Position of each individual in entries */
+        std::vector<Entry> entries; /**< Remembered individuals, in the order of the clock */
+        size_t hand; /**< Position of the clock hand in entries */
+
+        size_t hitCount; /**< Number of evaluations answered by the cache */
+        size_t missCount; /**< Number of evaluations forwarded to objective */
+
+        mutable std::mutex mutex; /**< Protects every member but objective */
+
+    };
+
+}
+
+#include "GA/Objective/CachedObjective.tpp"
+
+#endif //GENETICALGORITHM_CACHEDOBJECTIVE_H
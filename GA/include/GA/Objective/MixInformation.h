@@ -2,6 +2,7 @@
 #define GENETICALGORITHM_MIXINFORMATION_H
 
 #include <cstdlib>
+#include <vector>
 #include <GA/Representation/BinaryRepresentation.h>
 #include <FacilityLocation/Objective.h>
 
@@ -11,7 +12,7 @@ namespace GA {
     class MixInformation;
 
     template<size_t N, size_t M>
-    class MixInformation<GA::BinaryRepresentation<N>, GA::BinaryRepresentation<M>> : public GA::Objective<GA::BinaryRepresentation<M>> {
+    class MixInformation<GA::BinaryRepresentation<N>, GA::BinaryRepresentation<M>> final : public GA::Objective<GA::BinaryRepresentation<M>> {
         static_assert(M >= N, "Incompatible size of binary representation");
 
     public:
@@ -26,9 +27,12 @@ namespace GA {
         MixInformation& operator=(const MixInformation&) = default;
         MixInformation& operator=(MixInformation&&) = default;
 
-        double operator()(const GA::BinaryRepresentation<M> &individual);
+        double operator()(const GA::BinaryRepresentation<M> &individual) override;
+        void evaluate(const GA::BinaryRepresentation<M> *individuals, double *scores, size_t count) override;
 
     private:
+        GA::BinaryRepresentation<N> decode(const GA::BinaryRepresentation<M> &individual) const;
+
         Objective<GA::BinaryRepresentation<N>> &initialObjective;
         const size_t range;
 
@@ -0,0 +1,57 @@
+#ifndef GENETICALGORITHM_PARENTSAMPLING_H
+#define GENETICALGORITHM_PARENTSAMPLING_H
+
+#include <type_traits> // is_base_of
+
+#include "GA/Population.h"
+#include "GA/Random.h"
+#include "GA/Representation.h"
+
+namespace GA {
+
+    /**
+     * Interface of a parent sampling functor that can be bound to a GA::Engine.
+     * The engine calls prepare() once per generation on the current population, then
+     * draws the parents of each new individual with operator(). Implementations are
+     * expected to precompute in prepare() whatever is needed to draw a parent in
+     * constant time.
+     * @tparam Individual Type of individuals, must be a subclass of Representation
+     */
+    template<class Individual>
+    class ParentSampling {
+        static_assert(std::is_base_of<Representation, Individual>::value,
+                      "Individual not derived from Representation");
+
+    public:
+        using Population = GA::Population<Individual>;
+
+    public:
+        ParentSampling() = default;
+        ParentSampling(const ParentSampling&) = default;
+        ParentSampling(ParentSampling&&) = default;
+        virtual ~ParentSampling() = 0;
+
+        ParentSampling &operator=(const ParentSampling&) = default;
+        ParentSampling &operator=(ParentSampling&&) = default;
+
+        /**
+         * Precompute the sampling of parents in a population.
+         * @param population The population parents are drawn from, sorted after the scores
+         */
+        virtual void prepare(const Population &population) = 0;
+
+        /**
+         * Draw a parent in the last prepared population.
+         * @param rnd The random engine to draw from
+         * @return The index of the parent in the population
+         */
+        virtual size_t operator()(RandomEngine &rnd) = 0;
+
+    };
+
+    template<class Individual>
+    inline ParentSampling<Individual>::~ParentSampling() {}
+
+}
+
+#endif //GENETICALGORITHM_PARENTSAMPLING_H
@@ -0,0 +1,54 @@
+#ifndef GENETICALGORITHM_EXPONENTIALRANKSAMPLING_H
+#define GENETICALGORITHM_EXPONENTIALRANKSAMPLING_H
+
+#include <vector>
+
+#include "GA/AliasTable.h"
+#include "GA/ParentSampling.h"
+
+namespace GA {
+
+    /**
+     * Exponential ranking: the individual of rank i (0 for the best) is drawn with a
+     * probability proportional to ratio^i.
+     * A ratio close to 1 gives a low selection pressure, a small one restricts the
+     * reproduction to the very best individuals.
+     * @tparam Individual Type of individuals, must be a subclass of Representation
+     */
+    template<class Individual>
+    class ExponentialRankSampling final : public ParentSampling<Individual> {
+
+    public:
+        using Population = typename ParentSampling<Individual>::Population;
+
+    public:
+        ExponentialRankSampling() = delete;
+
+        ExponentialRankSampling(const ExponentialRankSampling&) = default;
+        ExponentialRankSampling(ExponentialRankSampling&&) = default;
+        ExponentialRankSampling(double ratio);
+        ~ExponentialRankSampling() = default;
+
+        ExponentialRankSampling &operator=(const ExponentialRankSampling&) = default;
+        ExponentialRankSampling &operator=(ExponentialRankSampling&&) = default;
+
+        double getRatio() const;
+        void setRatio(double ratio);
+
+        void prepare(const Population &population) override;
+        size_t operator()(RandomEngine &rnd) override;
+
+    private:
+        double ratio; /**< Ratio between the probabilities of two consecutive ranks */
+
+        AliasTable table; /**< Distribution of ranks, only depends on the population size */
+        bool tableValid; /**< Cleared when the ratio changes */
+        std::vector<double> weights; /**< Buffer of weights */
+
+    };
+
+}
+
+#include "GA/ParentSampling/ExponentialRankSampling.tpp"
+
+#endif //GENETICALGORITHM_EXPONENTIALRANKSAMPLING_H
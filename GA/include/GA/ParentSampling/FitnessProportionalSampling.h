@@ -0,0 +1,47 @@
+#ifndef GENETICALGORITHM_FITNESSPROPORTIONALSAMPLING_H
+#define GENETICALGORITHM_FITNESSPROPORTIONALSAMPLING_H
+
+#include <vector>
+
+#include "GA/AliasTable.h"
+#include "GA/ParentSampling.h"
+
+namespace GA {
+
+    /**
+     * Fitness proportional sampling, adapted to minimization: an individual is drawn
+     * with a probability proportional to the difference between the worst score of
+     * the population and its own score.
+     * Individuals with a non-finite score are never drawn. When every score is the
+     * same, parents are drawn uniformly.
+     * @tparam Individual Type of individuals, must be a subclass of Representation
+     */
+    template<class Individual>
+    class FitnessProportionalSampling final : public ParentSampling<Individual> {
+
+    public:
+        using Population = typename ParentSampling<Individual>::Population;
+
+    public:
+        FitnessProportionalSampling();
+        FitnessProportionalSampling(const FitnessProportionalSampling&) = default;
+        FitnessProportionalSampling(FitnessProportionalSampling&&) = default;
+        ~FitnessProportionalSampling() = default;
+
+        FitnessProportionalSampling &operator=(const FitnessProportionalSampling&) = default;
+        FitnessProportionalSampling &operator=(FitnessProportionalSampling&&) = default;
+
+        void prepare(const Population &population) override;
+        size_t operator()(RandomEngine &rnd) override;
+
+    private:
+        AliasTable table; /**< Distribution of indices, rebuilt for each population */
+        std::vector<double> weights; /**< Buffer of weights */
+
+    };
+
+}
+
+#include "GA/ParentSampling/FitnessProportionalSampling.tpp"
+
+#endif //GENETICALGORITHM_FITNESSPROPORTIONALSAMPLING_H
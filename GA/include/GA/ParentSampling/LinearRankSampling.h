@@ -0,0 +1,45 @@
+#ifndef GENETICALGORITHM_LINEARRANKSAMPLING_H
+#define GENETICALGORITHM_LINEARRANKSAMPLING_H
+
+#include <vector>
+
+#include "GA/AliasTable.h"
+#include "GA/ParentSampling.h"
+
+namespace GA {
+
+    /**
+     * Linear ranking: in a population of n individuals, the individual of rank i
+     * (0 for the best) is drawn with probability P(i) = (n-i) / (n(n+1)/2).
+     * This is the default sampling of GA::Engine.
+     * @tparam Individual Type of individuals, must be a subclass of Representation
+     */
+    template<class Individual>
+    class LinearRankSampling final : public ParentSampling<Individual> {
+
+    public:
+        using Population = typename ParentSampling<Individual>::Population;
+
+    public:
+        LinearRankSampling();
+        LinearRankSampling(const LinearRankSampling&) = default;
+        LinearRankSampling(LinearRankSampling&&) = default;
+        ~LinearRankSampling() = default;
+
+        LinearRankSampling &operator=(const LinearRankSampling&) = default;
+        LinearRankSampling &operator=(LinearRankSampling&&) = default;
+
+        void prepare(const Population &population) override;
+        size_t operator()(RandomEngine &rnd) override;
+
+    private:
+        AliasTable table; /**< Distribution of ranks, only depends on the population size */
+        std::vector<double> weights; /**< Buffer of weights */
+
+    };
+
+}
+
+#include "GA/ParentSampling/LinearRankSampling.tpp"
+
+#endif //GENETICALGORITHM_LINEARRANKSAMPLING_H
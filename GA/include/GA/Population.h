@@ -0,0 +1,176 @@
+#ifndef GENETICALGORITHM_POPULATION_H
+#define GENETICALGORITHM_POPULATION_H
+
+#include <type_traits> // is_base_of
+#include <vector>
+
+#include "GA/Representation.h"
+
+namespace GA {
+
+    /**
+     * A population, or a set of scored individuals.
+     * Individuals are stored contiguously in a vector, their scores in a parallel
+     * vector, so that adding an individual never allocates once enough memory has
+     * been reserved.
+     * <p>
+     * The ranking of individuals (lower scores first) is not maintained during
+     * insertion: the container only keeps track of the length of its sorted prefix,
+     * and sort() or partialSort(size_t) must be called before relying on ranks.
+     * Appending individuals in increasing order of score keeps the population sorted.
+     * @tparam Individual Type of individuals, must be a subclass of Representation
+     */
+    template<class Individual>
+    class Population {
+        static_assert(std::is_base_of<Representation, Individual>::value,
+                      "Individual not derived from Representation");
+
+    public:
+        Population();
+        Population(const Population&) = default;
+        Population(Population&&) = default;
+        ~Population() = default;
+
+        Population &operator=(const Population&) = default;
+        Population &operator=(Population&&) = default;
+
+        /**
+         * @return The number of individuals in the population
+         */
+        size_t size() const;
+
+        /**
+         * @return true if the population contains no individual
+         */
+        bool empty() const;
+
+        /**
+         * Remove every individual, the reserved memory is kept.
+         */
+        void clear();
+
+        /**
+         * Reserve memory for a given number of individuals.
+         * @param capacity The number of individuals to reserve
+         */
+        void reserve(size_t capacity);
+
+        /**
+         * Append an individual and its score to the population.
+         * @param score The score of the individual
+         * @param individual The individual
+         */
+        void add(double score, const Individual &individual);
+
+        /**
+         * Append an individual and its score to the population.
+         * @param score The score of the individual
+         * @param individual The individual
+         */
+        void add(double score, Individual &&individual);
+
+        /**
+         * Insert an individual at its rank in a sorted population.
+         * It is placed after the individuals with the same score. The population must be
+         * sorted, and stays so.
+         * @param score The score of the individual
+         * @param individual The individual
+         */
+        void insert(double score, Individual &&individual);
+
+        /**
+         * Replace the worst individual of a sorted population, in place.
+         * The new individual is moved to its rank by shifting the individuals between
+         * its rank and the end of the population. The population must be sorted and not
+         * empty, and stays sorted.
+         * @param score The score of the new individual
+         * @param individual The new individual
+         */
+        void replaceWorst(double score, Individual &&individual);
+
+        /**
+         * Keep only the first individuals of the population.
+         * @param count The number of individuals to keep
+         */
+        void truncate(size_t count);
+
+        /**
+         * @param index Index of the individual, the rank if the population is sorted
+         * @return The individual at the given index
+         */
+        const Individual &getIndividual(size_t index) const;
+
+        /**
+         * @param index Index of the individual, the rank if the population is sorted
+         * @return The score of the individual at the given index
+         */
+        double getScore(size_t index) const;
+
+        /**
+         * @return The contiguous array of individuals
+         */
+        const std::vector<Individual> &getIndividuals() const;
+
+        /**
+         * @return The contiguous array of scores, parallel to getIndividuals()
+         */
+        const std::vector<double> &getScores() const;
+
+        /**
+         * @return true if the whole population is ordered after the scores
+         */
+        bool isSorted() const;
+
+        /**
+         * @param count A number of individuals
+         * @return true if the first count individuals are the best ones, in order
+         */
+        bool isSorted(size_t count) const;
+
+        /**
+         * Order the whole population after the scores.
+         * The sort is stable: individuals with the same score keep their insertion order.
+         * Nothing is done if the population is already sorted.
+         */
+        void sort();
+
+        /**
+         * Move the count best individuals at the beginning of the population, in order.
+         * The order of the remaining individuals is unspecified.
+         * @param count The number of individuals to rank
+         */
+        void partialSort(size_t count);
+
+        /**
+         * Exchange the content of two populations.
+         * @param population The other population
+         */
+        void swap(Population &population);
+
+    private:
+        /**
+         * Reorder individuals and scores after the first count indices of order.
+         * @param count The number of valid indices at the beginning of order
+         */
+        void applyOrder(size_t count);
+
+        /**
+         * Move the last individual of a sorted population to its rank.
+         */
+        void rankLast();
+
+        std::vector<Individual> individuals; /**< Individuals of the population */
+        std::vector<double> scores; /**< Scores, parallel to individuals */
+        size_t sortedCount; /**< Length of the prefix holding the best individuals in order */
+
+        std::vector<size_t> order; /**< Buffer of indices used while sorting */
+        std::vector<Individual> individualsBuffer; /**< Buffer of individuals used while sorting */
+        std::vector<double> scoresBuffer; /**< Buffer of scores used while sorting */
+
+    };
+
+}
+
+#include "GA/Population.tpp"
+
+#endif //GENETICALGORITHM_POPULATION_H
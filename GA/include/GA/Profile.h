@@ -0,0 +1,213 @@
+#ifndef GENETICALGORITHM_PROFILE_H
+#define GENETICALGORITHM_PROFILE_H
+
+#include <cstdint> // uint64_t
+#include <cstdlib> // malloc, free, size_t
+#include <new> // bad_alloc
+#include <ostream>
+
+/*
+ * Instrumentation of the engine, enabled by defining GA_PROFILING (CMake option of the
+ * same name). Without it, the GA_PROFILE_* macros expand to nothing and a Profile
+ * stays empty.
+ * Allocations are only counted if GA_PROFILING_ALLOCATION_HOOK is expanded once in the
+ * program, at namespace scope: it replaces the global operator new.
+ * The allocation counter is per thread, so that concurrent engines do not count each
+ * other's allocations: allocations done on the workers of a GA::ThreadPool are not
+ * attributed to any phase.
+ */
+#ifdef GA_PROFILING
+#define GA_PROFILE_CONCAT_(a, b) a##b
+#define GA_PROFILE_CONCAT(a, b) GA_PROFILE_CONCAT_(a, b)
+#define GA_PROFILE_SCOPE(profile, phase) GA::ProfileScope GA_PROFILE_CONCAT(profileScope, __LINE__)(profile, phase)
+#define GA_PROFILE_GENERATION(profile) GA::ProfileGeneration GA_PROFILE_CONCAT(profileGeneration, __LINE__)(profile)
+#define GA_PROFILE_EVALUATIONS(profile, count) ((profile).evaluations += (count))
+#if defined(__GNUC__) && !defined(__clang__)
+// GCC does not know that the replaced operator new returns memory from malloc
+#define GA_PROFILE_DELETE_BEGIN_ \
+    _Pragma("GCC diagnostic push") \
+    _Pragma("GCC diagnostic ignored \"-Wmismatched-new-delete\"")
+#define GA_PROFILE_DELETE_END_ _Pragma("GCC diagnostic pop")
+#else
+#define GA_PROFILE_DELETE_BEGIN_
+#define GA_PROFILE_DELETE_END_
+#endif
+#ifdef __cpp_sized_deallocation
+#define GA_PROFILE_SIZED_DELETE_ \
+    void operator delete(void *pointer, size_t) noexcept { \
+        std::free(pointer); \
+    }
+#else
+#define GA_PROFILE_SIZED_DELETE_
+#endif
+#define GA_PROFILING_ALLOCATION_HOOK \
+    void *operator new(size_t size) { \
+        ++GA::Profile::allocationCounter(); \
+        void *pointer = std::malloc(size == 0 ? 1 : size); \
+        if (pointer == nullptr) { \
+            throw std::bad_alloc(); \
+        } \
+        return pointer; \
+    } \
+    GA_PROFILE_DELETE_BEGIN_ \
+    void operator delete(void *pointer) noexcept { \
+        std::free(pointer); \
+    } \
+    GA_PROFILE_SIZED_DELETE_ \
+    GA_PROFILE_DELETE_END_
+#else
+#define GA_PROFILE_SCOPE(profile, phase)
+#define GA_PROFILE_GENERATION(profile)
+#define GA_PROFILE_EVALUATIONS(profile, count)
+#define GA_PROFILING_ALLOCATION_HOOK
+#endif
+
+namespace GA {
+
+    /**
+     * Cumulative counters of the steps of a GA::Engine.
+     * Cycles are read from the time stamp counter of the processor where there is one,
+     * and are nanoseconds elsewhere.
+     */
+    struct Profile final {
+
+        /**
+         * The phases of a step.
+         */
+        enum Phase {
+            Selection, /**< Call to the selection functor */
+            ParentSampling, /**< Preparation of the parent sampling and draws of parents */
+            Crossover, /**< Calls to the crossover functor */
+            Mutation, /**< Calls to the mutation functor */
+            Objective, /**< Evaluation of new individuals */
+            Insertion, /**< Insertion of new individuals in the population */
+            PhaseCount /**< Number of phases */
+        };
+
+        /**
+         * true if the engine is compiled with GA_PROFILING
+         */
+#ifdef GA_PROFILING
+        static constexpr bool enabled = true;
+#else
+        static constexpr bool enabled = false;
+#endif
+
+        uint64_t cycles[PhaseCount] = {}; /**< Cycles spent in each phase */
+        uint64_t allocations[PhaseCount] = {}; /**< Allocations done in each phase */
+        uint64_t generations = 0; /**< Number of profiled steps */
+        uint64_t evaluations = 0; /**< Number of calls to the objective */
+        double seconds = 0.; /**< Wall time of the profiled steps */
+
+        /**
+         * Clear every counter.
+         */
+        void reset();
+
+        /**
+         * Add the cycles and allocations of the phases of another profile, gathered by
+         * another thread on part of the same steps.
+         * @param profile The profile to add
+         */
+        void add(const Profile &profile);
+
+        /**
+         * @return The total number of cycles of the phases
+         */
+        uint64_t getTotalCycles() const;
+
+        /**
+         * @return The total number of allocations of the phases
+         */
+        uint64_t getTotalAllocations() const;
+
+        /**
+         * @return The number of calls to the objective per second of steps
+         */
+        double getEvaluationsPerSecond() const;
+
+        /**
+         * Write the counters as a JSON object.
+         * @param out The output stream
+         */
+        void writeJson(std::ostream &out) const;
+
+        /**
+         * @param phase A phase
+         * @return The name of the phase, as used in the JSON output
+         */
+        static const char *getPhaseName(Phase phase);
+
+        /**
+         * @return The current value of the cycle counter
+         */
+        static uint64_t readCycles();
+
+        /**
+         * @return The number of allocations of the calling thread counted by
+         * GA_PROFILING_ALLOCATION_HOOK
+         */
+        static uint64_t &allocationCounter();
+
+    };
+
+    /**
+     * Add the cycles and allocations of its lifetime to a phase of a profile.
+     */
+    class ProfileScope final {
+
+    public:
+        ProfileScope() = delete;
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope(ProfileScope&&) = delete;
+
+        /**
+         * @param profile The profile to update
+         * @param phase The phase measured
+         */
+        ProfileScope(Profile &profile, Profile::Phase phase);
+
+        ~ProfileScope();
+
+        ProfileScope &operator=(const ProfileScope&) = delete;
+        ProfileScope &operator=(ProfileScope&&) = delete;
+
+    private:
+        Profile &profile; /**< The profile to update */
+        const Profile::Phase phase; /**< The phase measured */
+        const uint64_t startCycles; /**< Cycle counter at the construction */
+        const uint64_t startAllocations; /**< Allocation counter at the construction */
+
+    };
+
+    /**
+     * Add its lifetime to the wall time of a profile, as a generation.
+     */
+    class ProfileGeneration final {
+
+    public:
+        ProfileGeneration() = delete;
+        ProfileGeneration(const ProfileGeneration&) = delete;
+        ProfileGeneration(ProfileGeneration&&) = delete;
+
+        /**
+         * @param profile The profile to update
+         */
+        explicit ProfileGeneration(Profile &profile);
+
+        ~ProfileGeneration();
+
+        ProfileGeneration &operator=(const ProfileGeneration&) = delete;
+        ProfileGeneration &operator=(ProfileGeneration&&) = delete;
+
+    private:
+        Profile &profile; /**< The profile to update */
+        const uint64_t startNanoseconds; /**< Time of the construction */
+
+    };
+
+}
+
+#include "GA/Profile.tpp"
+
+#endif //GENETICALGORITHM_PROFILE_H
@@ -0,0 +1,18 @@
+#ifndef GENETICALGORITHM_RANDOM_H
+#define GENETICALGORITHM_RANDOM_H
+
+#include <random>
+
+namespace GA {
+
+    /**
+     * Random engine shared by the functors of a GA::Engine.
+     * The engine owns a single instance and hands it to every functor call, so that a
+     * run is entirely determined by the seed of the engine. Each call produces 64 random
+     * bits, which is the granularity used to randomize binary individuals.
+     */
+    using RandomEngine = std::mt19937_64;
+
+}
+
+#endif //GENETICALGORITHM_RANDOM_H
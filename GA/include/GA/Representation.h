@@ -1,14 +1,21 @@
 #ifndef GENETICALGORITHM_REPRESENTATION_H
 #define GENETICALGORITHM_REPRESENTATION_H
 
+#include "GA/Random.h"
+
 namespace GA {
 
     /**
-     * Interface of a software representation of an individual.
+     * Base of a software representation of an individual.
      * Subclasses are intended to be a mask of specialization of required functor
      * of the genetic algorithm (many of them needs to know the internal structure
      * to do their job).
-     * An required feature must be implemented: randomize()
+     * The base is empty and has no virtual function, so that an individual holds
+     * nothing but its own data and copies stay cheap.
+     * An required feature must be implemented: randomize(RandomEngine&), which
+     * erases the information contained in the individual and replaces it with a
+     * new random individual, independent of its previous state, drawn from the given
+     * random engine.
      */
     class Representation {
 
@@ -16,21 +23,13 @@ namespace GA {
         Representation() = default;
         Representation(const Representation&) = default;
         Representation(Representation&&) = default;
-        virtual ~Representation() = 0;
+        ~Representation() = default;
 
         Representation &operator=(const Representation&) = default;
         Representation &operator=(Representation&&) = default;
 
-        /**
-         * Erases the information contained in the individual.
-         * A call to this function will generate a new random individual
-         * independent of its previous state.
-         */
-        virtual void randomize() = 0;
     };
 
-    inline Representation::~Representation() {}
-
 }
 
 #endif //GENETICALGORITHM_REPRESENTATION_H
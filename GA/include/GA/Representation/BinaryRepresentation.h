@@ -1,35 +1,248 @@
 #ifndef GENETICALGORITHM_BINARYREPRESENTATION_H
 #define GENETICALGORITHM_BINARYREPRESENTATION_H
 
-#include <bitset>
-#include <random>
+#include <cstdint> // uint64_t
+#include <cstdlib> // size_t
+#include <functional> // hash
+#include <vector>
 
+#include "GA/Random.h"
 #include "GA/Representation.h"
 
 namespace GA {
 
     /**
-     * TODO: documentation
+     * An individual made of N bits, packed in 64 bits words.
+     * The interface follows the one of std::bitset. The individual holds nothing but
+     * its words: it is trivially copyable, and its construction only clears the words.
+     * <p>
+     * N = 0 selects the specialization BinaryRepresentation<0>, whose number of bits is
+     * chosen at runtime.
      * @tparam N Number of bits
      */
     template<size_t N>
-    class BinaryRepresentation : public Representation, public std::bitset<N> {
+    class BinaryRepresentation : public Representation {
+
+    public:
+        /**
+         * Number of 64 bits words needed to store the bits, as used by
+         * getWords(uint64_t*) and setWords(const uint64_t*).
+         */
+        static constexpr size_t wordCount = (N + 63) / 64;
+
+    public:
+        BinaryRepresentation();
+        BinaryRepresentation(const BinaryRepresentation&) = default;
+        BinaryRepresentation(BinaryRepresentation&&) = default;
+        BinaryRepresentation(unsigned long long val);
+        ~BinaryRepresentation() = default;
+
+        BinaryRepresentation &operator=(const BinaryRepresentation&) = default;
+        BinaryRepresentation &operator=(BinaryRepresentation&&) = default;
+
+        /**
+         * Draw every bit uniformly, one call to the random engine per word.
+         * @param rnd The random engine
+         */
+        void randomize(RandomEngine &rnd);
+
+        /**
+         * @return The number of bits, N
+         */
+        constexpr size_t size() const { return N; }
+
+        /**
+         * @return The number of words, wordCount
+         */
+        constexpr size_t getWordCount() const { return wordCount; }
+
+        /**
+         * Provided for code written against both the fixed and runtime sizes.
+         * @param size The number of bits, must be N
+         */
+        void resize(size_t size);
+
+        bool operator[](size_t pos) const;
+        bool test(size_t pos) const;
+
+        BinaryRepresentation &set();
+        BinaryRepresentation &set(size_t pos, bool value = true);
+        BinaryRepresentation &reset();
+        BinaryRepresentation &reset(size_t pos);
+        BinaryRepresentation &flip();
+        BinaryRepresentation &flip(size_t pos);
+
+        /**
+         * @return The number of bits set
+         */
+        size_t count() const;
+        bool any() const;
+        bool none() const;
+
+        bool operator==(const BinaryRepresentation &other) const;
+        bool operator!=(const BinaryRepresentation &other) const;
+
+        /**
+         * @param index Index of a word, lower than wordCount
+         * @return The word holding the bits [64*index, 64*index+64)
+         */
+        uint64_t getWord(size_t index) const;
+
+        /**
+         * Replace a word. Bits of the last word beyond N must be zero.
+         * @param index Index of a word, lower than wordCount
+         * @param word The new value of the bits [64*index, 64*index+64)
+         */
+        void setWord(size_t index, uint64_t word);
+
+        /**
+         * Pack the bits in 64 bits words, bit i being the bit i%64 of word i/64.
+         * Unused bits of the last word are zero.
+         * @param words Array of wordCount words receiving the bits
+         */
+        void getWords(uint64_t *words) const;
+
+        /**
+         * Unpack bits stored by getWords(uint64_t*).
+         * @param words Array of wordCount words holding the bits
+         */
+        void setWords(const uint64_t *words);
+
+    private:
+        /**
+         * Mask of the bits of the last word lower than N.
+         */
+        static constexpr uint64_t lastWordMask = (N % 64 == 0) ? ~uint64_t(0) : (uint64_t(1) << (N % 64)) - 1;
+
+        uint64_t words[wordCount]; /**< Bits, bit i being the bit i%64 of words[i/64] */
+
+    };
+
+    /**
+     * An individual made of a number of bits chosen at runtime, packed in 64 bits words.
+     * The interface is the one of BinaryRepresentation<N>, the number of words being
+     * given by getWordCount(). Words are allocated on the heap, so that a copy costs an
+     * allocation: the fixed size is faster when the number of bits is known at compile
+     * time.
+     * <p>
+     * Default constructed individuals hold no bit. Individuals of different sizes are
+     * never equal, and operators expect their parents to have the same size.
+     */
+    template<>
+    class BinaryRepresentation<0> : public Representation {
 
     public:
         BinaryRepresentation();
         BinaryRepresentation(const BinaryRepresentation&) = default;
         BinaryRepresentation(BinaryRepresentation&&) = default;
-        BinaryRepresentation(unsigned long val);
+
+        /**
+         * @param size The number of bits
+         * @param val The value of the first 64 bits, truncated to size
+         */
+        explicit BinaryRepresentation(size_t size, unsigned long long val = 0);
+
         ~BinaryRepresentation() = default;
 
-        BinaryRepresentation &operator=(BinaryRepresentation&) = default;
+        BinaryRepresentation &operator=(const BinaryRepresentation&) = default;
         BinaryRepresentation &operator=(BinaryRepresentation&&) = default;
 
-        void randomize() override;
+        /**
+         * Draw every bit uniformly, one call to the random engine per word.
+         * @param rnd The random engine
+         */
+        void randomize(RandomEngine &rnd);
+
+        /**
+         * @return The number of bits
+         */
+        size_t size() const;
+
+        /**
+         * @return The number of 64 bits words needed to store the bits, as used by
+         * getWords(uint64_t*) and setWords(const uint64_t*)
+         */
+        size_t getWordCount() const;
+
+        /**
+         * Change the number of bits. Bits lower than both sizes are kept, new bits are zero.
+         * @param size The new number of bits
+         */
+        void resize(size_t size);
+
+        bool operator[](size_t pos) const;
+        bool test(size_t pos) const;
+
+        BinaryRepresentation &set();
+        BinaryRepresentation &set(size_t pos, bool value = true);
+        BinaryRepresentation &reset();
+        BinaryRepresentation &reset(size_t pos);
+        BinaryRepresentation &flip();
+        BinaryRepresentation &flip(size_t pos);
+
+        /**
+         * @return The number of bits set
+         */
+        size_t count() const;
+        bool any() const;
+        bool none() const;
+
+        bool operator==(const BinaryRepresentation &other) const;
+        bool operator!=(const BinaryRepresentation &other) const;
+
+        /**
+         * @param index Index of a word, lower than getWordCount()
+         * @return The word holding the bits [64*index, 64*index+64)
+         */
+        uint64_t getWord(size_t index) const;
+
+        /**
+         * Replace a word. Bits of the last word beyond size() must be zero.
+         * @param index Index of a word, lower than getWordCount()
+         * @param word The new value of the bits [64*index, 64*index+64)
+         */
+        void setWord(size_t index, uint64_t word);
+
+        /**
+         * Pack the bits in 64 bits words, bit i being the bit i%64 of word i/64.
+         * Unused bits of the last word are zero.
+         * @param words Array of getWordCount() words receiving the bits
+         */
+        void getWords(uint64_t *words) const;
+
+        /**
+         * Unpack bits stored by getWords(uint64_t*).
+         * @param words Array of getWordCount() words holding the bits
+         */
+        void setWords(const uint64_t *words);
 
     private:
-        std::default_random_engine rnd;
+        /**
+         * Clear the bits of the last word beyond size().
+         */
+        void clearUnusedBits();
+
+        size_t bitCount; /**< Number of bits */
+        std::vector<uint64_t> words; /**< Bits, bit i being the bit i%64 of words[i/64] */
+
+    };
+
+    /**
+     * Binary representation whose number of bits is chosen at runtime.
+     */
+    using DynamicBinaryRepresentation = BinaryRepresentation<0>;
 
+}
+
+namespace std {
+
+    /**
+     * Hash of a binary representation, computed on its packed bits.
+     * @tparam N Number of bits
+     */
+    template<size_t N>
+    struct hash<GA::BinaryRepresentation<N>> {
+        size_t operator()(const GA::BinaryRepresentation<N> &individual) const noexcept;
     };
 
 }
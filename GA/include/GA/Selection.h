@@ -3,8 +3,8 @@
 
 #include <type_traits> // is_base_of
 
-#include <map>
-
+#include "GA/Population.h"
+#include "GA/Random.h"
 #include "GA/Representation.h"
 
 namespace GA {
@@ -20,7 +20,7 @@ namespace GA {
                       "Individual not derived from Representation");
 
     public:
-        using Population = std::multimap<double, Individual>;
+        using Population = GA::Population<Individual>;
 
     public:
         Selection() = default;
@@ -34,10 +34,13 @@ namespace GA {
         /**
          * Perform a selection on a population. The given population is not modified
          * Every individuals in the final population are in the initial population.
-         * @param population The initial population
+         * The engine always gives a sorted population, and the best individuals should
+         * come first in the returned population.
+         * @param population The initial population, sorted after the scores
+         * @param rnd The random engine to draw from, if the selection is not deterministic
          * @return A population with at least one individual
          */
-        virtual Population operator()(const Population &population) = 0;
+        virtual Population operator()(const Population &population, RandomEngine &rnd) = 0;
 
     };
 
@@ -11,7 +11,7 @@ namespace GA {
      * @tparam Individual Type of individuals, must be a subclass of Representation
      */
     template<class Individual>
-    class ElitismSelection : public Selection<Individual> {
+    class ElitismSelection final : public Selection<Individual> {
         static_assert(std::is_base_of<Representation, Individual>::value,
                       "Individual not derived from Representation");
 
@@ -32,7 +32,7 @@ namespace GA {
         double getProportionSurvival() const;
         void setProportionSurvival(double proportionSurvival);
 
-        Population operator()(const Population &population) override;
+        Population operator()(const Population &population, RandomEngine &rnd) override;
 
     protected:
         double proportionSurvival;
@@ -1,5 +1,5 @@
-#ifndef GENETICALGORITHM_ELITISMSELECTION_H
-#define GENETICALGORITHM_ELITISMSELECTION_H
+#ifndef GENETICALGORITHM_PROBABILISTSELECTION_H
+#define GENETICALGORITHM_PROBABILISTSELECTION_H
 
 #include "GA/Selection.h"
 #include "GA/Representation/BinaryRepresentation.h"
@@ -11,7 +11,7 @@ namespace GA {
      * @tparam Individual Type of individuals, must be a subclass of Representation
      */
     template<class Individual>
-    class ProbabilistSelection : public Selection<Individual> {
+    class ProbabilistSelection final : public Selection<Individual> {
         static_assert(std::is_base_of<Representation, Individual>::value,
                       "Individual not derived from Representation");
 
@@ -27,7 +27,7 @@ namespace GA {
         ProbabilistSelection &operator=(const ProbabilistSelection&) = default;
         ProbabilistSelection &operator=(ProbabilistSelection&&) = default;
 
-        Population operator()(const Population &population) override;
+        Population operator()(const Population &population, RandomEngine &rnd) override;
 
     };
 
@@ -35,4 +35,4 @@ namespace GA {
 
 #include "GA/Selection/ProbabilistSelection.tpp"
 
-#endif //GENETICALGORITHM_ELITISMSELECTION_H
+#endif //GENETICALGORITHM_PROBABILISTSELECTION_H
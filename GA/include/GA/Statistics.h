@@ -0,0 +1,121 @@
+#ifndef GENETICALGORITHM_STATISTICS_H
+#define GENETICALGORITHM_STATISTICS_H
+
+#include <cstdlib> // size_t
+
+namespace GA {
+
+    /**
+     * Mean and standard deviation of a stream of values, in one pass.
+     * Values are accumulated with the algorithm of Welford, which stays accurate when
+     * the values are large compared to their spread.
+     */
+    class RunningStatistics final {
+
+    public:
+        RunningStatistics();
+        RunningStatistics(const RunningStatistics&) = default;
+        RunningStatistics(RunningStatistics&&) = default;
+        ~RunningStatistics() = default;
+
+        RunningStatistics &operator=(const RunningStatistics&) = default;
+        RunningStatistics &operator=(RunningStatistics&&) = default;
+
+        /**
+         * Add a value to the stream.
+         * @param value The value
+         */
+        void add(double value);
+
+        /**
+         * @return The number of values
+         */
+        size_t getCount() const;
+
+        /**
+         * @return The mean of the values, 0 if there is none
+         */
+        double getMean() const;
+
+        /**
+         * @return The standard deviation of the values, as a population, 0 if there is
+         * less than 2 values
+         */
+        double getStandardDeviation() const;
+
+    private:
+        size_t count; /**< Number of values */
+        double mean; /**< Mean of the values */
+        double squaredDeviations; /**< Sum of the squared deviations to the mean */
+
+    };
+
+    /**
+     * Estimation of a quantile of a stream of values, in one pass and constant memory.
+     * It follows the P² algorithm of Jain and Chlamtac: five markers track the minimum,
+     * the quantile, the quantiles halfway to the extrema and the maximum, and are moved
+     * along a parabolic interpolation as values arrive. The estimate is exact up to
+     * five values.
+     */
+    class QuantileEstimator final {
+
+    public:
+        QuantileEstimator() = delete;
+        QuantileEstimator(const QuantileEstimator&) = default;
+        QuantileEstimator(QuantileEstimator&&) = default;
+
+        /**
+         * @param probability The probability of the quantile, in [0, 1]
+         */
+        explicit QuantileEstimator(double probability);
+
+        ~QuantileEstimator() = default;
+
+        QuantileEstimator &operator=(const QuantileEstimator&) = default;
+        QuantileEstimator &operator=(QuantileEstimator&&) = default;
+
+        /**
+         * Add a value to the stream.
+         * @param value The value
+         */
+        void add(double value);
+
+        /**
+         * @return The number of values
+         */
+        size_t getCount() const;
+
+        /**
+         * @return The estimate of the quantile, 0 if there is no value
+         */
+        double getQuantile() const;
+
+    private:
+        /**
+         * @param i Index of an inner marker
+         * @param d Direction of the move, -1 or 1
+         * @return The parabolic prediction of the height of the marker moved by d
+         */
+        double parabolic(size_t i, double d) const;
+
+        /**
+         * @param i Index of an inner marker
+         * @param d Direction of the move, -1 or 1
+         * @return The linear prediction of the height of the marker moved by d
+         */
+        double linear(size_t i, double d) const;
+
+        double probability; /**< Probability of the quantile */
+        size_t count; /**< Number of values */
+        double heights[5]; /**< Heights of the markers, the first values while count < 5 */
+        double positions[5]; /**< Positions of the markers */
+        double desired[5]; /**< Desired positions of the markers */
+        double increments[5]; /**< Increments of the desired positions */
+
+    };
+
+}
+
+#include "GA/Statistics.tpp"
+
+#endif //GENETICALGORITHM_STATISTICS_H
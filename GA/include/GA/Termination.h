@@ -0,0 +1,223 @@
+#ifndef GENETICALGORITHM_TERMINATION_H
+#define GENETICALGORITHM_TERMINATION_H
+
+#include <chrono>
+#include <ctime> // clock_gettime
+
+namespace GA {
+
+    /**
+     * The budget of a run of a GA::Engine, made of one or several criteria.
+     * Criteria are combined with Combination::AnyOf (the run stops as soon as one of
+     * them is reached, the default) or Combination::AllOf (the run stops once all of
+     * them are reached). Limits on generations and evaluations count from the start of
+     * the run.
+     * <p>
+     * The clock is not read at every generation: the number of generations between two
+     * readings is adapted to the speed of the run, so that the time limit is
+     * overshot by about the time resolution at most.
+     * <p>
+     * The CPU time is the one of the thread running the engine, so that runs sharing
+     * the processors with other runs get comparable budgets. Evaluations done by other
+     * threads are not counted: it is meant for engines using a single thread.
+     */
+    class Termination final {
+
+    public:
+        /**
+         * Criteria of termination, as bits of the result of Engine::run.
+         */
+        enum Criterion : unsigned int {
+            Time = 1u << 0, /**< The run lasted for the time limit */
+            Generations = 1u << 1, /**< The run lasted for the generation limit */
+            Evaluations = 1u << 2, /**< The objective was called as many times as the evaluation limit */
+            TargetScore = 1u << 3, /**< The best score is lower than or equal to the target score */
+            Stall = 1u << 4, /**< The best score did not improve for the stall limit of generations */
+            CpuTime = 1u << 5 /**< The calling thread used the processor for the CPU time limit */
+        };
+
+        /**
+         * The way criteria are combined.
+         */
+        enum class Combination {
+            AnyOf, /**< Stop when one of the criteria is reached */
+            AllOf /**< Stop when every criterion is reached */
+        };
+
+    public:
+        Termination();
+        Termination(const Termination&) = default;
+        Termination(Termination&&) = default;
+        ~Termination() = default;
+
+        Termination &operator=(const Termination&) = default;
+        Termination &operator=(Termination&&) = default;
+
+        /**
+         * @return The bits of the criteria in use
+         */
+        unsigned int getCriteria() const;
+
+        /**
+         * @return The way criteria are combined
+         * @see setCombination(Combination)
+         */
+        Combination getCombination() const;
+
+        /**
+         * @return The time limit in seconds
+         * @see setTimeLimit(double)
+         */
+        double getTimeLimit() const;
+
+        /**
+         * @return The CPU time limit in seconds
+         * @see setCpuTimeLimit(double)
+         */
+        double getCpuTimeLimit() const;
+
+        /**
+         * @return The maximal number of generations
+         * @see setGenerationLimit(unsigned long)
+         */
+        unsigned long getGenerationLimit() const;
+
+        /**
+         * @return The maximal number of evaluations
+         * @see setEvaluationLimit(unsigned long)
+         */
+        unsigned long getEvaluationLimit() const;
+
+        /**
+         * @return The score to reach
+         * @see setTargetScore(double)
+         */
+        double getTargetScore() const;
+
+        /**
+         * @return The number of generations without improvement before a stall
+         * @see setStallLimit(unsigned long)
+         */
+        unsigned long getStallLimit() const;
+
+        /**
+         * @return The aimed precision of the time limit in seconds
+         * @see setTimeResolution(double)
+         */
+        double getTimeResolution() const;
+
+        /**
+         * Set the way criteria are combined, Combination::AnyOf by default.
+         * @param combination The new combination
+         */
+        void setCombination(Combination combination);
+
+        /**
+         * Use the Time criterion.
+         * @param seconds The duration of the run, in seconds
+         */
+        void setTimeLimit(double seconds);
+
+        /**
+         * Use the CpuTime criterion.
+         * @param seconds The CPU time of the run, in seconds
+         */
+        void setCpuTimeLimit(double seconds);
+
+        /**
+         * Use the Generations criterion.
+         * @param generations The number of generations of the run
+         */
+        void setGenerationLimit(unsigned long generations);
+
+        /**
+         * Use the Evaluations criterion.
+         * @param evaluations The number of calls to the objective during the run
+         */
+        void setEvaluationLimit(unsigned long evaluations);
+
+        /**
+         * Use the TargetScore criterion.
+         * @param score The score under which the run is done
+         */
+        void setTargetScore(double score);
+
+        /**
+         * Use the Stall criterion.
+         * @param generations The number of generations without improvement of the
+         * best score after which the run is stalled
+         */
+        void setStallLimit(unsigned long generations);
+
+        /**
+         * Set the aimed precision of the time limit, 1 ms by default.
+         * A coarser resolution reads the clock less often.
+         * @param seconds A strictly positive duration, in seconds
+         */
+        void setTimeResolution(double seconds);
+
+        /**
+         * Stop using a criterion.
+         * @param criterion The criterion
+         */
+        void clear(Criterion criterion);
+
+        /**
+         * Start a run. Called by the engine.
+         * @param generation The generation counter of the engine
+         * @param evaluations The evaluation counter of the engine
+         * @param score The current best score
+         */
+        void start(unsigned long generation, unsigned long evaluations, double score);
+
+        /**
+         * Check the criteria after a generation. Called by the engine.
+         * @param generation The generation counter of the engine
+         * @param evaluations The evaluation counter of the engine
+         * @param score The current best score
+         * @return 0 if the run must go on, the bits of the reached criteria otherwise
+         */
+        unsigned int check(unsigned long generation, unsigned long evaluations, double score);
+
+        /**
+         * @return The CPU time used by the calling thread, in seconds
+         */
+        static double getThreadCpuTime();
+
+    private:
+        /**
+         * Read the clocks of the time criteria in use.
+         * @param generation The generation counter of the engine
+         */
+        void checkClocks(unsigned long generation);
+
+        using Clock = std::chrono::steady_clock;
+        using Duration = std::chrono::duration<double>;
+
+        unsigned int criteria; /**< Bits of the criteria in use */
+        Combination combination; /**< The way criteria are combined */
+        double timeLimit; /**< Duration of the run in seconds */
+        double cpuTimeLimit; /**< CPU time of the run in seconds */
+        unsigned long generationLimit; /**< Number of generations of the run */
+        unsigned long evaluationLimit; /**< Number of evaluations of the run */
+        double targetScore; /**< Score to reach */
+        unsigned long stallLimit; /**< Number of generations without improvement */
+        double timeResolution; /**< Aimed precision of the time limit in seconds */
+
+        Clock::time_point startTime; /**< Time of the start of the run */
+        double startCpuTime; /**< CPU time of the thread at the start of the run */
+        unsigned long startGeneration; /**< Generation counter at the start of the run */
+        unsigned long startEvaluations; /**< Evaluation counter at the start of the run */
+        unsigned long nextClockCheck; /**< Generation at which the clock is read next */
+        bool timeReached; /**< Set once the time limit is reached */
+        bool cpuTimeReached; /**< Set once the CPU time limit is reached */
+        double bestScore; /**< Best score seen during the run */
+        unsigned long lastImprovement; /**< Generation of the last improvement of bestScore */
+
+    };
+
+}
+
+#include "GA/Termination.tpp"
+
+#endif //GENETICALGORITHM_TERMINATION_H
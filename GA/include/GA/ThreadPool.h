@@ -0,0 +1,96 @@
+#ifndef GENETICALGORITHM_THREADPOOL_H
+#define GENETICALGORITHM_THREADPOOL_H
+
+#include <condition_variable>
+#include <cstdlib> // size_t
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GA {
+
+    /**
+     * A fixed set of worker threads executing submitted tasks.
+     * A pool can be shared between several engines: the calling thread always takes
+     * part in the work of a parallelFor(size_t, size_t, Function), so that nested or
+     * concurrent calls can not dead-lock, even when every worker is busy.
+     */
+    class ThreadPool final {
+
+    public:
+        ThreadPool() = delete;
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool(ThreadPool&&) = delete;
+
+        /**
+         * Create a pool able to run threadCount tasks at the same time.
+         * The calling thread counts as one of them, so threadCount-1 workers are
+         * started.
+         * @param threadCount The number of threads, 0 is understood as 1
+         */
+        explicit ThreadPool(size_t threadCount);
+
+        /**
+         * Wait for the completion of every submitted task and stop the workers.
+         */
+        ~ThreadPool();
+
+        ThreadPool &operator=(const ThreadPool&) = delete;
+        ThreadPool &operator=(ThreadPool&&) = delete;
+
+        /**
+         * @return A process-wide pool with one thread per hardware thread
+         */
+        static ThreadPool &shared();
+
+        /**
+         * @return The number of threads working on a parallelFor, calling thread included
+         */
+        size_t getThreadCount() const;
+
+        /**
+         * Queue a task to be run by a worker.
+         * If the pool has no worker, the task is run immediately by the calling thread.
+         * @param task The task
+         */
+        void submit(std::function<void()> task);
+
+        /**
+         * Wait until every submitted task is done.
+         */
+        void wait();
+
+        /**
+         * Call function(first, last) over consecutive chunks covering [begin, end).
+         * The call returns once every chunk has been processed. Chunks are independent
+         * of the number of threads, so that results built per chunk are deterministic.
+         * @tparam Function Callable as function(size_t first, size_t last)
+         * @param begin First index
+         * @param end Index past the last one
+         * @param function The function to call on each chunk
+         * @param grain The maximal number of indices in a chunk, 0 for automatic
+         */
+        template<class Function>
+        void parallelFor(size_t begin, size_t end, Function function, size_t grain = 0);
+
+    private:
+        void work();
+
+        std::vector<std::thread> workers; /**< Started workers */
+        std::deque<std::function<void()>> tasks; /**< Tasks waiting for a worker */
+        size_t pending; /**< Number of submitted tasks not yet done */
+        bool stopping; /**< Set when the workers must quit */
+
+        std::mutex mutex; /**< Protects tasks, pending and stopping */
+        std::condition_variable taskAvailable; /**< Signaled when a task is queued */
+        std::condition_variable taskDone; /**< Signaled when pending reaches 0 */
+
+    };
+
+}
+
+#include "GA/ThreadPool.tpp"
+
+#endif //GENETICALGORITHM_THREADPOOL_H
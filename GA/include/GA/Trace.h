@@ -0,0 +1,244 @@
+#ifndef GENETICALGORITHM_TRACE_H
+#define GENETICALGORITHM_TRACE_H
+
+#include <condition_variable>
+#include <cstdint> // uint64_t
+#include <cstdlib> // size_t
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace GA {
+
+    /**
+     * Columns of a convergence trace: one sample per recorded generation.
+     */
+    struct TraceColumns {
+        std::vector<double> times; /**< Time of each sample, in the unit of the recorder */
+        std::vector<uint64_t> evaluations; /**< Number of evaluations done at each sample */
+        std::vector<double> best; /**< Best score at each sample */
+        std::vector<double> mean; /**< Mean score of the population at each sample */
+
+        /**
+         * @return The number of samples
+         */
+        size_t size() const;
+
+        /**
+         * Remove every sample, the reserved memory is kept.
+         */
+        void clear();
+    };
+
+    /**
+     * Record the convergence of a run into a binary file.
+     * Samples are gathered in blocks of columns, and full blocks are written by a
+     * background thread, so that recording a sample never waits for the disk. It is
+     * meant to be called from the callback of Engine::run.
+     * <p>
+     * Samples can be decimated: a sample is dropped if it comes less than the interval
+     * after the last kept one. The last sample of the run is always kept: close() keeps
+     * the last sample given with its mean, and finish(double, const Engine&) the
+     * final state of an engine.
+     * <p>
+     * The file is made of a header (magic number, version), followed by blocks. A block
+     * holds its number of samples n, then n times, n evaluation counts, n best scores
+     * and n mean scores. Values are stored in the byte order of the machine.
+     * @see TraceReader
+     */
+    class TraceWriter final {
+
+    public:
+        static constexpr uint64_t magic = 0x3145434152544147; /**< First word of a trace file, "GATRACE1" */
+        static constexpr uint64_t version = 1; /**< Version of the format, second word of a trace file */
+
+    public:
+        TraceWriter();
+        TraceWriter(const TraceWriter&) = delete;
+        TraceWriter(TraceWriter&&) = delete;
+
+        /**
+         * Close the file if it is still open.
+         */
+        ~TraceWriter();
+
+        TraceWriter &operator=(const TraceWriter&) = delete;
+        TraceWriter &operator=(TraceWriter&&) = delete;
+
+        /**
+         * Create a trace file and start the background writer.
+         * @param filename Path of the file
+         * @return false if the file can not be created
+         */
+        bool open(const std::string &filename);
+
+        /**
+         * @return true if a file is open
+         */
+        bool isOpen() const;
+
+        /**
+         * @return The minimal time between two kept samples
+         * @see setInterval(double)
+         */
+        double getInterval() const;
+
+        /**
+         * Set the minimal time between two kept samples, 0 (no decimation) by default.
+         * @param interval The interval, in the unit of the recorded times
+         */
+        void setInterval(double interval);
+
+        /**
+         * Record a sample. The file must be open.
+         * @param time The time of the sample, increasing from one sample to the next
+         * @param evaluations The number of evaluations done
+         * @param best The best score
+         * @param mean The mean score of the population
+         */
+        void record(double time, uint64_t evaluations, double best, double mean);
+
+        /**
+         * Record the state of an engine. The file must be open.
+         * The mean score costs a pass over the population, so it is only computed for
+         * kept samples, and dropped samples are discarded: call finish at the end of
+         * the run to keep its last state.
+         * @tparam Engine A GA::Engine
+         * @param time The time of the sample, increasing from one sample to the next
+         * @param engine The engine
+         */
+        template<class Engine>
+        void record(double time, const Engine &engine);
+
+        /**
+         * Record the final state of an engine, whatever the interval, unless a sample
+         * was already kept at this time. The file must be open.
+         * @tparam Engine A GA::Engine
+         * @param time The time of the sample, not before the last recorded one
+         * @param engine The engine
+         */
+        template<class Engine>
+        void finish(double time, const Engine &engine);
+
+        /**
+         * Write the remaining samples, stop the background writer and close the file.
+         * @return false if an error occurred while writing
+         */
+        bool close();
+
+    private:
+        static constexpr size_t blockSize = 4096; /**< Number of samples of a full block */
+
+        /**
+         * @param time The time of a sample
+         * @return true if the sample is to be dropped, being too close to the last kept one
+         */
+        bool isDropped(double time) const;
+
+        /**
+         * Keep a dropped sample aside, in case it is the last one of the run.
+         */
+        void hold(double time, uint64_t evaluations, double best, double mean);
+
+        /**
+         * @tparam Engine A GA::Engine
+         * @param engine The engine
+         * @return The mean score of its population, its best score if it is empty
+         */
+        template<class Engine>
+        static double getMean(const Engine &engine);
+
+        /**
+         * Append a sample to the current block, handing the block over once full.
+         */
+        void append(double time, uint64_t evaluations, double best, double mean);
+
+        /**
+         * Hand the current block over to the background writer.
+         * Waits if the writer is still busy with the previous block.
+         */
+        void submit();
+
+        /**
+         * Loop of the background writer.
+         */
+        void work();
+
+        std::ofstream file; /**< The trace file */
+        double interval; /**< Minimal time between two kept samples */
+        bool hasKept; /**< Set once a sample has been kept */
+        double lastKeptTime; /**< Time of the last kept sample */
+        bool hasDropped; /**< Set if the last recorded sample was dropped */
+        double droppedTime; /**< Time of the last recorded sample, if dropped */
+        uint64_t droppedEvaluations; /**< Evaluations of the last recorded sample, if dropped */
+        double droppedBest; /**< Best score of the last recorded sample, if dropped */
+        double droppedMean; /**< Mean score of the last recorded sample, if dropped */
+
+        TraceColumns current; /**< Block receiving the samples */
+        TraceColumns flushing; /**< Block being written by the background writer */
+        bool flushPending; /**< Set while the background writer owns flushing */
+        bool stopping; /**< Set when the background writer must quit */
+        bool failed; /**< Set if a write failed */
+        std::thread writer; /**< The background writer */
+        std::mutex mutex; /**< Protects flushPending, stopping and failed */
+        std::condition_variable changed; /**< Signaled when flushPending or stopping change */
+
+    };
+
+    /**
+     * Load a trace written by a TraceWriter.
+     */
+    class TraceReader final {
+
+    public:
+        TraceReader() = default;
+        TraceReader(const TraceReader&) = default;
+        TraceReader(TraceReader&&) = default;
+        ~TraceReader() = default;
+
+        TraceReader &operator=(const TraceReader&) = default;
+        TraceReader &operator=(TraceReader&&) = default;
+
+        /**
+         * Read a trace file, replacing the current samples.
+         * @param filename Path of the file
+         * @return false if the file can not be read or is not a valid trace, the
+         * samples are then left empty
+         */
+        bool load(const std::string &filename);
+
+        /**
+         * @return The number of samples
+         */
+        size_t size() const;
+
+        /**
+         * @return The columns of the samples
+         */
+        const TraceColumns &getColumns() const;
+
+        /**
+         * Visit the blocks of a trace held in memory, typically a mapped file, without
+         * copying them. Blocks are visited in order, up to the first invalid one.
+         * @tparam Function Callable as function(size_t count, const double *times,
+         * const uint64_t *evaluations, const double *best, const double *mean)
+         * @param data The content of the file, aligned on 8 bytes
+         * @param size The size of the file in bytes
+         * @param function The function called on each block
+         * @return false if the content is not a valid trace
+         */
+        template<class Function>
+        static bool parse(const char *data, size_t size, Function function);
+
+    private:
+        TraceColumns columns; /**< Samples of the trace */
+
+    };
+
+}
+
+#include "GA/Trace.tpp"
+
+#endif //GENETICALGORITHM_TRACE_H
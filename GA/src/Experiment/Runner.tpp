@@ -0,0 +1,543 @@
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cmath> // abs
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <random> // seed_seq
+#include <set>
+#include <stdexcept> // runtime_error
+#include <thread>
+#include <sys/stat.h> // mkdir
+#include <Experiment/Runner.h>
+#include "FacilityLocation/Objective.h"
+#include "GA/Crossover/MultiPointCrossover.h"
+#include "GA/Crossover/SinglePointCrossover.h"
+#include "GA/Engine.h"
+#include "GA/Mutation/RandomMutation.h"
+#include "GA/Objective/DeadBitInsertion.h"
+#include "GA/Objective/DuplicateBits.h"
+#include "GA/Objective/MixInformation.h"
+#include "GA/Profile.h"
+#include "GA/Selection/ElitismSelection.h"
+#include "GA/Termination.h"
+#include "GA/Trace.h"
+#include "GA/ThreadPool.h"
+
+template<size_t NF>
+Experiment::Runner<NF>::Runner(const Sweep &sweep) :
+        sweep(sweep),
+        instance(),
+        settings(),
+        jobs(),
+        defaultOutput(),
+        threadCount(0) {
+}
+
+template<size_t NF>
+bool Experiment::Runner<NF>::prepare() {
+    settings.clear();
+    jobs.clear();
+    bool valid = this->prepareInstance();
+
+    const Configuration &run = sweep.getRun();
+    threadCount = 0;
+    if (!run.get("threads", threadCount)) {
+        std::cerr << "[run]: threads must be a non-negative integer" << std::endl;
+        valid = false;
+    }
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    settings.resize(sweep.getConfigurations().size());
+    for (size_t i = 0; i < settings.size(); ++i) {
+        valid = this->prepareSetting(sweep.getConfigurations()[i], settings[i]) && valid;
+    }
+    if (!valid) {
+        return false;
+    }
+
+    // Replicates first, so that the first results of every configuration come early
+    unsigned long replicateMax = 0;
+    for (const Setting &setting: settings) {
+        replicateMax = std::max(replicateMax, setting.replicates);
+    }
+    for (unsigned long replicate = 0; replicate < replicateMax; ++replicate) {
+        for (const Setting &setting: settings) {
+            if (replicate < setting.replicates) {
+                jobs.push_back(Job{&setting, replicate});
+            }
+        }
+    }
+    return true;
+}
+
+template<size_t NF>
+const FacilityLocation::Instance<NF> &Experiment::Runner<NF>::getInstance() const {
+    assert(instance);
+    return *instance;
+}
+
+template<size_t NF>
+size_t Experiment::Runner<NF>::getJobCount() const {
+    return jobs.size();
+}
+
+template<size_t NF>
+size_t Experiment::Runner<NF>::getThreadCount() const {
+    return threadCount;
+}
+
+template<size_t NF>
+bool Experiment::Runner<NF>::run() {
+    for (const Setting &setting: settings) {
+        if (!makeDirectories(setting.path)) {
+            std::cerr << "Can't create directory " << setting.path << std::endl;
+            return false;
+        }
+    }
+
+    std::atomic<size_t> done(0);
+    std::atomic<bool> succeeded(true);
+    std::mutex outputMutex;
+    const size_t jobCount = jobs.size();
+    {
+        // The calling thread only waits, every job runs on a worker
+        GA::ThreadPool threadPool(threadCount + 1);
+        for (const Job &job: jobs) {
+            threadPool.submit([this, &job, &done, &succeeded, &outputMutex, jobCount]() {
+                if (!this->runJob(job)) {
+                    succeeded = false;
+                }
+                size_t count = ++done;
+                std::lock_guard<std::mutex> lock(outputMutex);
+                std::cout << (100 * count / jobCount) << "% (" << count << "/" << jobCount << ")\r" << std::flush;
+            });
+        }
+        threadPool.wait();
+    }
+    std::cout << std::endl;
+    return succeeded;
+}
+
+template<size_t NF>
+bool Experiment::Runner<NF>::prepareInstance() {
+    const Configuration &configuration = sweep.getInstance();
+    std::string generator = "flawed-metric";
+    unsigned long numberCustomer = 1000;
+    unsigned long numberFacility = NF != 0 ? NF : 100;
+    unsigned long instanceSeed = 1;
+    bool ordered = false;
+    std::string filename;
+    std::string layout = "facility-major";
+    std::string precision = "double";
+    unsigned long candidateCount = 0;
+    bool valid = true;
+    configuration.get("generator", generator);
+    configuration.get("file", filename);
+    configuration.get("layout", layout);
+    configuration.get("precision", precision);
+    if (!configuration.get("customers", numberCustomer) || numberCustomer == 0) {
+        std::cerr << "[instance]: customers must be a positive integer" << std::endl;
+        valid = false;
+    }
+    if (!configuration.get("facilities", numberFacility) || numberFacility == 0
+        || (NF != 0 && numberFacility != NF)) {
+        std::cerr << "[instance]: facilities must be "
+                  << (NF != 0 ? "the compiled number of facilities, " + std::to_string(NF) : "a positive integer")
+                  << std::endl;
+        valid = false;
+    }
+    if (!configuration.get("seed", instanceSeed)) {
+        std::cerr << "[instance]: seed must be a non-negative integer" << std::endl;
+        valid = false;
+    }
+    if (!configuration.get("ordered", ordered)) {
+        std::cerr << "[instance]: ordered must be true or false" << std::endl;
+        valid = false;
+    }
+    if (!configuration.get("candidates", candidateCount)) {
+        std::cerr << "[instance]: candidates must be a non-negative integer" << std::endl;
+        valid = false;
+    }
+    for (const auto &parameter: configuration.getParameters()) {
+        if (parameter.first != "generator" && parameter.first != "customers" && parameter.first != "facilities"
+            && parameter.first != "seed" && parameter.first != "ordered" && parameter.first != "file"
+            && parameter.first != "layout" && parameter.first != "precision"
+            && parameter.first != "candidates") {
+            std::cerr << "[instance]: unknown key " << parameter.first << std::endl;
+            valid = false;
+        }
+    }
+    if ((generator == "file") != !filename.empty()) {
+        std::cerr << "[instance]: file must be given with the file generator, and only with it" << std::endl;
+        valid = false;
+    }
+    if (layout != "facility-major" && layout != "customer-major" && layout != "blocked") {
+        std::cerr << "[instance]: unknown layout " << layout << std::endl;
+        valid = false;
+    }
+    if (precision != "double" && precision != "float" && precision != "fixed16") {
+        std::cerr << "[instance]: unknown precision " << precision << std::endl;
+        valid = false;
+    }
+    if (!valid) {
+        return false;
+    }
+
+    using Instance = FacilityLocation::Instance<NF>;
+    auto instanceSeed32 = (unsigned int) instanceSeed;
+    if (generator == "random") {
+        instance.reset(new Instance(Instance::randomInstance(numberCustomer, instanceSeed32, numberFacility)));
+    } else if (generator == "metric") {
+        instance.reset(new Instance(Instance::randomMetricInstance(numberCustomer, instanceSeed32, ordered,
+                                                                          numberFacility)));
+    } else if (generator == "flawed-metric") {
+        instance.reset(new Instance(Instance::randomFlawedMetricInstance(numberCustomer, instanceSeed32, ordered,
+                                                                                numberFacility)));
+    } else if (generator == "file") {
+        try {
+            instance.reset(new Instance(Instance::load(filename)));
+        } catch (const std::runtime_error &error) {
+            std::cerr << "[instance]: " << error.what() << std::endl;
+            return false;
+        }
+    } else {
+        std::cerr << "[instance]: unknown generator " << generator << std::endl;
+        return false;
+    }
+    if (layout == "customer-major") {
+        instance->setLayout(FacilityLocation::Layout::CustomerMajor);
+    } else if (layout == "blocked") {
+        instance->setLayout(FacilityLocation::Layout::Blocked);
+    }
+    if (precision == "float") {
+        instance->setPrecision(FacilityLocation::Precision::Float);
+    } else if (precision == "fixed16") {
+        instance->setPrecision(FacilityLocation::Precision::Fixed16);
+    }
+    if (candidateCount != 0) {
+        instance->setCandidateCount(candidateCount);
+    }
+    defaultOutput = "output/" + std::to_string(instance->getNumberFacility()) + "-" + std::to_string(instance->getNumberCustomer()) + "-"
+                    + (generator == "file" ? filename.substr(filename.find_last_of('/') + 1)
+                                           : std::to_string(instanceSeed) + (ordered ? "-ordered" : ""));
+    return true;
+}
+
+template<size_t NF>
+bool Experiment::Runner<NF>::prepareSetting(const Configuration &configuration, Setting &setting) const {
+    static const std::set<std::string> keys = {
+            "output", "threads", "seed", "cpu-time", "replicates", "trace-interval",
+            "encoding", "redundancy", "position", "offset", "range",
+            "crossover", "points", "mutation", "selection", "population"
+    };
+
+    if (!instance) {
+        // The reason was reported by prepareInstance()
+        return false;
+    }
+    const size_t numberFacility = instance->getNumberFacility();
+    const std::string &name = configuration.getName();
+    bool valid = true;
+    auto error = [&name, &valid](const std::string &message) {
+        std::cerr << "[" << name << "]: " << message << std::endl;
+        valid = false;
+    };
+    for (const auto &parameter: configuration.getParameters()) {
+        if (keys.find(parameter.first) == keys.end()) {
+            error("unknown key " + parameter.first);
+        }
+    }
+
+    // Jobs of every configuration share a single pool
+    std::string threads, runThreads;
+    configuration.get("threads", threads);
+    sweep.getRun().get("threads", runThreads);
+    if (threads != runThreads) {
+        error("threads can only be set in [run]");
+    }
+
+    setting.seed = 1;
+    if (!configuration.get("seed", setting.seed)) {
+        error("seed must be a non-negative integer");
+    }
+
+    std::string output = defaultOutput;
+    configuration.get("output", output);
+    setting.path = output + "/" + name;
+
+    std::string encoding = "none";
+    configuration.get("encoding", encoding);
+    if (encoding == "none") {
+        setting.encoding = Encoding::None;
+    } else if (encoding == "dead-bit") {
+        setting.encoding = Encoding::DeadBit;
+    } else if (encoding == "duplicate") {
+        setting.encoding = Encoding::Duplicate;
+    } else if (encoding == "mix") {
+        setting.encoding = Encoding::Mix;
+    } else {
+        error("unknown encoding " + encoding);
+        setting.encoding = Encoding::None;
+    }
+    if (NF == 0 && setting.encoding != Encoding::None) {
+        error("the " + encoding + " encoding needs a number of facilities fixed at compile time");
+        setting.encoding = Encoding::None;
+    }
+
+    double redundancy = 1.;
+    setting.halfRedundancy = 0;
+    if (!configuration.get("redundancy", redundancy)) {
+        error("redundancy must be a number");
+    }
+    for (unsigned int halfRedundancy: {2u, 3u, 4u, 6u, 10u, 14u, 18u, 22u}) {
+        if (std::abs(redundancy * 2. - halfRedundancy) < 1e-9) {
+            setting.halfRedundancy = halfRedundancy;
+        }
+    }
+    if (setting.halfRedundancy == 0) {
+        error("redundancy must be one of 1, 1.5, 2, 3, 5, 7, 9 or 11");
+    }
+    const size_t bits = numberFacility * setting.halfRedundancy / 2;
+
+    setting.encodingParameter = 0;
+    const char *parameterKey = nullptr;
+    switch (setting.encoding) {
+        case Encoding::None:
+            if (setting.halfRedundancy != 2) {
+                error("redundancy must be 1 without encoding");
+            }
+            break;
+        case Encoding::DeadBit:
+            parameterKey = "position";
+            if (!configuration.get("position", setting.encodingParameter) || setting.encodingParameter >= numberFacility) {
+                error("position must be an integer lower than " + std::to_string(numberFacility));
+            }
+            break;
+        case Encoding::Duplicate:
+            parameterKey = "offset";
+            if (setting.halfRedundancy % 2 != 0) {
+                error("redundancy must be an integer with the duplicate encoding");
+            }
+            if (!configuration.get("offset", setting.encodingParameter)) {
+                error("offset must be a non-negative integer");
+            }
+            break;
+        case Encoding::Mix:
+            parameterKey = "range";
+            setting.encodingParameter = bits - numberFacility + 1;
+            if (!configuration.get("range", setting.encodingParameter)
+                || setting.encodingParameter <= bits - numberFacility || setting.encodingParameter >= bits) {
+                error("range must be an integer in ]" + std::to_string(bits - numberFacility) + ", " + std::to_string(bits) + "[");
+            }
+            break;
+    }
+    for (const char *key: {"position", "offset", "range"}) {
+        if (configuration.has(key) && (parameterKey == nullptr || key != std::string(parameterKey))) {
+            error(std::string(key) + " does not apply to the " + encoding + " encoding");
+        }
+    }
+
+    std::string crossover = "single-point";
+    configuration.get("crossover", crossover);
+    setting.multiPoint = crossover == "multi-point";
+    if (!setting.multiPoint && crossover != "single-point") {
+        error("unknown crossover " + crossover);
+    }
+    setting.points = 1;
+    if (!configuration.get("points", setting.points) || setting.points == 0) {
+        error("points must be a positive integer");
+    }
+
+    setting.mutation = 1.;
+    if (!configuration.get("mutation", setting.mutation)
+        || setting.mutation > (double) numberFacility || setting.mutation < 0.) {
+        error("mutation must be a number in [0, " + std::to_string(numberFacility) + "]");
+    }
+    setting.mutation /= (double) numberFacility;
+
+    setting.selection = 0.05;
+    if (!configuration.get("selection", setting.selection) || setting.selection < 0. || setting.selection > 1.) {
+        error("selection must be a number in [0, 1]");
+    }
+
+    setting.population = 128;
+    if (!configuration.get("population", setting.population) || setting.population < 2) {
+        error("population must be an integer greater than 1");
+    }
+
+    setting.cpuTime = 1.;
+    if (!configuration.get("cpu-time", setting.cpuTime) || !(setting.cpuTime > 0.)) {
+        error("cpu-time must be a positive number");
+    }
+
+    setting.replicates = 100;
+    if (!configuration.get("replicates", setting.replicates)) {
+        error("replicates must be a non-negative integer");
+    }
+
+    setting.traceInterval = 0.;
+    if (!configuration.get("trace-interval", setting.traceInterval) || setting.traceInterval < 0.) {
+        error("trace-interval must be a non-negative number");
+    }
+
+    return valid;
+}
+
+template<size_t NF>
+bool Experiment::Runner<NF>::runJob(const Job &job) const {
+    return this->runJob(job, std::integral_constant<bool, NF != 0>());
+}
+
+template<size_t NF>
+bool Experiment::Runner<NF>::runJob(const Job &job, std::true_type) const {
+    switch (job.setting->halfRedundancy) {
+        case 2:
+            return this->runEncoded<NF>(job);
+        case 3:
+            return this->runEncoded<NF * 3 / 2>(job);
+        case 4:
+            return this->runEncoded<NF * 2>(job);
+        case 6:
+            return this->runEncoded<NF * 3>(job);
+        case 10:
+            return this->runEncoded<NF * 5>(job);
+        case 14:
+            return this->runEncoded<NF * 7>(job);
+        case 18:
+            return this->runEncoded<NF * 9>(job);
+        case 22:
+            return this->runEncoded<NF * 11>(job);
+        default:
+            assert(false);
+            return false;
+    }
+}
+
+template<size_t NF>
+bool Experiment::Runner<NF>::runJob(const Job &job, std::false_type) const {
+    assert(job.setting->encoding == Encoding::None); // Others are rejected by prepareSetting
+    FacilityLocation::Objective<GA::BinaryRepresentation<NF>> objective(*instance);
+    return this->evolve<NF>(job, objective);
+}
+
+template<size_t NF>
+template<size_t M>
+bool Experiment::Runner<NF>::runEncoded(const Job &job) const {
+    using Individual = GA::BinaryRepresentation<NF>;
+    using EncodedIndividual = GA::BinaryRepresentation<M>;
+    FacilityLocation::Objective<Individual> objective(*instance);
+
+    switch (job.setting->encoding) {
+        case Encoding::None:
+            // Only instantiated as a pass-through when M == NF
+            return this->evolve<NF>(job, objective);
+        case Encoding::DeadBit: {
+            GA::DeadBitInsertion<Individual, EncodedIndividual> decoder(objective, job.setting->encodingParameter);
+            return this->evolve<M>(job, decoder);
+        }
+        case Encoding::Duplicate:
+            return this->runDuplicate<M>(job, objective, std::integral_constant<bool, M % NF == 0>());
+        case Encoding::Mix: {
+            GA::MixInformation<Individual, EncodedIndividual> decoder(objective, job.setting->encodingParameter);
+            return this->evolve<M>(job, decoder);
+        }
+    }
+    return false;
+}
+
+template<size_t NF>
+template<size_t M>
+bool Experiment::Runner<NF>::runDuplicate(const Job &job, GA::Objective<GA::BinaryRepresentation<NF>> &objective,
+                                          std::true_type) const {
+    GA::DuplicateBits<GA::BinaryRepresentation<NF>, GA::BinaryRepresentation<M>> decoder(
+            objective, job.setting->encodingParameter);
+    return this->evolve<M>(job, decoder);
+}
+
+template<size_t NF>
+template<size_t M>
+bool Experiment::Runner<NF>::runDuplicate(const Job &, GA::Objective<GA::BinaryRepresentation<NF>> &,
+                                          std::false_type) const {
+    assert(false); // Rejected by prepareSetting
+    return false;
+}
+
+template<size_t NF>
+template<size_t M>
+bool Experiment::Runner<NF>::evolve(const Job &job, GA::Objective<GA::BinaryRepresentation<M>> &objective) const {
+    using Individual = GA::BinaryRepresentation<M>;
+    const Setting &setting = *job.setting;
+
+    GA::SinglePointCrossover<Individual> singlePointCrossover;
+    GA::MultiPointCrossover<Individual> multiPointCrossover((unsigned int) setting.points);
+    GA::Crossover<Individual> &crossover = setting.multiPoint
+                                           ? static_cast<GA::Crossover<Individual>&>(multiPointCrossover)
+                                           : static_cast<GA::Crossover<Individual>&>(singlePointCrossover);
+    GA::RandomMutation<Individual> mutation(setting.mutation);
+    GA::ElitismSelection<Individual> selection(setting.selection);
+    GA::Engine<Individual> ga(objective, crossover, mutation, selection);
+    ga.setSeed(this->getSeed(setting, job.replicate));
+    Individual prototype;
+    prototype.resize(M != 0 ? M : instance->getNumberFacility());
+    ga.setPrototype(prototype);
+
+    const std::string filename = setting.path + "/" + std::to_string(job.replicate);
+    GA::TraceWriter trace;
+    trace.setInterval(setting.traceInterval);
+    if (!trace.open(filename + ".trace")) {
+        std::cerr << "Can't open file " << filename << ".trace" << std::endl;
+        return false;
+    }
+
+    const double start = GA::Termination::getThreadCpuTime();
+    ga.initialize(setting.population);
+    double elapsed = GA::Termination::getThreadCpuTime() - start;
+    trace.record(elapsed, ga);
+
+    if (elapsed < setting.cpuTime) {
+        GA::Termination termination;
+        termination.setCpuTimeLimit(setting.cpuTime - elapsed);
+        ga.run(termination, [&trace, &elapsed, start](const GA::Engine<Individual> &engine) {
+            elapsed = GA::Termination::getThreadCpuTime() - start;
+            trace.record(elapsed, engine);
+        });
+    }
+    trace.finish(elapsed, ga);
+    if (!trace.close()) {
+        std::cerr << "Can't write file " << filename << ".trace" << std::endl;
+        return false;
+    }
+
+    if (GA::Profile::enabled) {
+        std::ofstream profileFile(filename + ".profile.json");
+        ga.getProfile().writeJson(profileFile);
+        profileFile << std::endl;
+    }
+    return true;
+}
+
+template<size_t NF>
+uint64_t Experiment::Runner<NF>::getSeed(const Setting &setting, unsigned long replicate) {
+    const unsigned long seed = setting.seed;
+    std::seed_seq sequence{(uint32_t) seed, (uint32_t) (seed >> 32), (uint32_t) replicate, (uint32_t) (replicate >> 32)};
+    uint32_t words[2];
+    sequence.generate(words, words + 2);
+    return (uint64_t) words[0] << 32 | words[1];
+}
+
+template<size_t NF>
+bool Experiment::Runner<NF>::makeDirectories(const std::string &path) {
+    size_t position = 0;
+    while (position != std::string::npos) {
+        position = path.find('/', position + 1);
+        std::string directory = path.substr(0, position);
+        if (!directory.empty() && mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST) {
+            return false;
+        }
+    }
+    return true;
+}
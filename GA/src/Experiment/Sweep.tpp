@@ -0,0 +1,237 @@
+#include <cerrno>
+#include <cstdlib> // strtod, strtoul
+#include <fstream>
+#include <iostream>
+#include <Experiment/Sweep.h>
+
+inline Experiment::Configuration::Configuration(std::string name, std::map<std::string, std::string> parameters) :
+        name(std::move(name)),
+        parameters(std::move(parameters)) {
+}
+
+inline const std::string &Experiment::Configuration::getName() const {
+    return name;
+}
+
+inline const std::map<std::string, std::string> &Experiment::Configuration::getParameters() const {
+    return parameters;
+}
+
+inline bool Experiment::Configuration::has(const std::string &key) const {
+    return parameters.find(key) != parameters.end();
+}
+
+inline bool Experiment::Configuration::get(const std::string &key, std::string &value) const {
+    auto it = parameters.find(key);
+    if (it != parameters.end()) {
+        value = it->second;
+    }
+    return true;
+}
+
+inline bool Experiment::Configuration::get(const std::string &key, double &value) const {
+    auto it = parameters.find(key);
+    if (it == parameters.end()) {
+        return true;
+    }
+    const char *begin = it->second.c_str();
+    char *end;
+    errno = 0;
+    double result = std::strtod(begin, &end);
+    if (end == begin || *end != '\0' || errno != 0) {
+        return false;
+    }
+    value = result;
+    return true;
+}
+
+inline bool Experiment::Configuration::get(const std::string &key, unsigned long &value) const {
+    auto it = parameters.find(key);
+    if (it == parameters.end()) {
+        return true;
+    }
+    const char *begin = it->second.c_str();
+    char *end;
+    errno = 0;
+    unsigned long result = std::strtoul(begin, &end, 10);
+    if (end == begin || *end != '\0' || errno != 0 || it->second[0] == '-') {
+        return false;
+    }
+    value = result;
+    return true;
+}
+
+inline bool Experiment::Configuration::get(const std::string &key, bool &value) const {
+    auto it = parameters.find(key);
+    if (it == parameters.end()) {
+        return true;
+    }
+    if (it->second == "true") {
+        value = true;
+    } else if (it->second == "false") {
+        value = false;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+inline bool Experiment::Sweep::load(const std::string &filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        std::cerr << "Can't open file " << filename << std::endl;
+        return false;
+    }
+
+    // Read every section before expanding, so that [run] can come last
+    std::vector<std::pair<std::string, Section>> sections;
+    std::vector<size_t> sectionLines;
+    bool valid = true;
+    auto error = [&filename, &valid](size_t lineNumber, const std::string &message) {
+        std::cerr << filename << ":" << lineNumber << ": " << message << std::endl;
+        valid = false;
+    };
+
+    std::string line;
+    size_t lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+        line = trim(line.substr(0, line.find('#')));
+        if (line.empty()) {
+            continue;
+        }
+
+        if (line.front() == '[') {
+            if (line.size() < 2 || line.back() != ']' || trim(line.substr(1, line.size() - 2)).empty()) {
+                error(lineNumber, "malformed section header");
+                continue;
+            }
+            std::string name = trim(line.substr(1, line.size() - 2));
+            for (const auto &section: sections) {
+                if (section.first == name) {
+                    error(lineNumber, "duplicate section [" + name + "]");
+                }
+            }
+            sections.emplace_back(name, Section());
+            sectionLines.push_back(lineNumber);
+            continue;
+        }
+
+        size_t equal = line.find('=');
+        if (equal == std::string::npos) {
+            error(lineNumber, "expected key = value");
+            continue;
+        }
+        if (sections.empty()) {
+            error(lineNumber, "key outside of any section");
+            continue;
+        }
+        std::string key = trim(line.substr(0, equal));
+        std::vector<std::string> values;
+        std::string list = line.substr(equal + 1);
+        size_t begin = 0;
+        while (true) {
+            size_t comma = list.find(',', begin);
+            values.push_back(trim(list.substr(begin, comma == std::string::npos ? std::string::npos : comma - begin)));
+            if (comma == std::string::npos) {
+                break;
+            }
+            begin = comma + 1;
+        }
+        if (key.empty()) {
+            error(lineNumber, "empty key");
+            continue;
+        }
+        bool emptyValue = false;
+        for (const std::string &value: values) {
+            emptyValue = emptyValue || value.empty();
+        }
+        if (emptyValue) {
+            error(lineNumber, "empty value for " + key);
+            continue;
+        }
+        Section &section = sections.back().second;
+        for (const auto &entry: section) {
+            if (entry.first == key) {
+                error(lineNumber, "duplicate key " + key);
+            }
+        }
+        section.emplace_back(key, values);
+    }
+
+    instance = Configuration("instance", {});
+    run = Configuration("run", {});
+    configurations.clear();
+    for (size_t i = 0; i < sections.size(); ++i) {
+        const std::string &name = sections[i].first;
+        if (name != "instance" && name != "run") {
+            continue;
+        }
+        std::map<std::string, std::string> parameters;
+        for (const auto &entry: sections[i].second) {
+            if (entry.second.size() != 1) {
+                error(sectionLines[i], "lists are not allowed in [" + name + "]");
+            }
+            parameters[entry.first] = entry.second.front();
+        }
+        (name == "instance" ? instance : run) = Configuration(name, std::move(parameters));
+    }
+    if (!valid) {
+        return false;
+    }
+
+    for (const auto &section: sections) {
+        if (section.first != "instance" && section.first != "run") {
+            this->expand(section.first, section.second);
+        }
+    }
+    return true;
+}
+
+inline const Experiment::Configuration &Experiment::Sweep::getInstance() const {
+    return instance;
+}
+
+inline const Experiment::Configuration &Experiment::Sweep::getRun() const {
+    return run;
+}
+
+inline const std::vector<Experiment::Configuration> &Experiment::Sweep::getConfigurations() const {
+    return configurations;
+}
+
+inline void Experiment::Sweep::expand(const std::string &name, const Section &section) {
+    // Odometer over the lists, the last key varies the fastest
+    std::vector<size_t> indices(section.size(), 0);
+    while (true) {
+        std::map<std::string, std::string> parameters = run.getParameters();
+        std::string label;
+        for (size_t i = 0; i < section.size(); ++i) {
+            const std::vector<std::string> &values = section[i].second;
+            parameters[section[i].first] = values[indices[i]];
+            if (values.size() > 1) {
+                label += (label.empty() ? "" : "_") + values[indices[i]];
+            }
+        }
+        configurations.emplace_back(name + "/" + (label.empty() ? "0" : label), std::move(parameters));
+
+        size_t i = section.size();
+        while (i > 0 && ++indices[i - 1] == section[i - 1].second.size()) {
+            indices[i - 1] = 0;
+            --i;
+        }
+        if (i == 0) {
+            return;
+        }
+    }
+}
+
+inline std::string Experiment::Sweep::trim(const std::string &text) {
+    const char *blanks = " \t\r\n";
+    size_t begin = text.find_first_not_of(blanks);
+    if (begin == std::string::npos) {
+        return std::string();
+    }
+    size_t end = text.find_last_not_of(blanks);
+    return text.substr(begin, end - begin + 1);
+}
@@ -0,0 +1,273 @@
+#include <algorithm> // fill
+#include <cassert>
+#include <cmath> // INFINITY
+#include <FacilityLocation/IncrementalEvaluator.h>
+#include <FacilityLocation/Kernel.h>
+
+template<size_t NF>
+constexpr size_t FacilityLocation::IncrementalEvaluator<NF>::none;
+
+template<size_t NF>
+FacilityLocation::IncrementalEvaluator<NF>::IncrementalEvaluator(const FacilityLocation::Instance<NF> &instance) :
+        instance(instance),
+        solution(),
+        score(INFINITY),
+        openCount(0),
+        nearest(instance.getNumberCustomer(), none),
+        secondNearest(instance.getNumberCustomer(), none),
+        nearestDistance(instance.getNumberCustomer(), INFINITY),
+        secondDistance(instance.getNumberCustomer(), INFINITY),
+        served(instance.getNumberFacility()),
+        servedPosition(instance.getNumberCustomer(), 0) {
+    assert(instance.getLayout() == Layout::FacilityMajor && instance.getPrecision() == Precision::Double);
+    solution.resize(instance.getNumberFacility());
+}
+
+template<size_t NF>
+void FacilityLocation::IncrementalEvaluator<NF>::reset(const Individual &solution) {
+    assert(solution.size() == instance.getNumberFacility());
+    const size_t numberCustomer = instance.getNumberCustomer();
+    this->solution = solution;
+    openCount = solution.count();
+    std::fill(nearest.begin(), nearest.end(), none);
+    std::fill(secondNearest.begin(), secondNearest.end(), none);
+    std::fill(nearestDistance.begin(), nearestDistance.end(), INFINITY);
+    std::fill(secondDistance.begin(), secondDistance.end(), INFINITY);
+    for (std::vector<size_t> &customers: served) {
+        customers.clear();
+    }
+
+    // Facilities then customers, in the order of the objective, for the same score
+    score = 0.;
+    for (size_t iF = 0; iF < instance.getNumberFacility(); ++iF) {
+        if (!solution[iF]) {
+            continue;
+        }
+        score += instance.cost(iF);
+        const double *row = instance.getDistanceRow(iF);
+        for (size_t iC = 0; iC < numberCustomer; ++iC) {
+            if (row[iC] < nearestDistance[iC]) {
+                secondNearest[iC] = nearest[iC];
+                secondDistance[iC] = nearestDistance[iC];
+                nearest[iC] = iF;
+                nearestDistance[iC] = row[iC];
+            } else if (row[iC] < secondDistance[iC]) {
+                secondNearest[iC] = iF;
+                secondDistance[iC] = row[iC];
+            }
+        }
+    }
+    for (size_t iC = 0; iC < numberCustomer; ++iC) {
+        score += nearestDistance[iC];
+        if (nearest[iC] != none) {
+            this->attach(iC, nearest[iC]);
+        }
+    }
+}
+
+template<size_t NF>
+const typename FacilityLocation::IncrementalEvaluator<NF>::Individual &
+FacilityLocation::IncrementalEvaluator<NF>::getSolution() const {
+    return solution;
+}
+
+template<size_t NF>
+double FacilityLocation::IncrementalEvaluator<NF>::getScore() const {
+    return score;
+}
+
+template<size_t NF>
+size_t FacilityLocation::IncrementalEvaluator<NF>::getOpenCount() const {
+    return openCount;
+}
+
+template<size_t NF>
+size_t FacilityLocation::IncrementalEvaluator<NF>::getNearest(size_t customer) const {
+    assert(customer < nearest.size());
+    return nearest[customer];
+}
+
+template<size_t NF>
+size_t FacilityLocation::IncrementalEvaluator<NF>::getSecondNearest(size_t customer) const {
+    assert(customer < secondNearest.size());
+    return secondNearest[customer];
+}
+
+template<size_t NF>
+double FacilityLocation::IncrementalEvaluator<NF>::getFlipDelta(size_t facility) const {
+    assert(facility < instance.getNumberFacility());
+    if (solution[facility]) {
+        // Customers of the facility move to their second nearest facility
+        double delta = -instance.cost(facility);
+        for (size_t iC: served[facility]) {
+            delta += secondDistance[iC] - nearestDistance[iC];
+        }
+        return delta;
+    }
+    if (openCount == 0) {
+        return -INFINITY;
+    }
+    // Customers nearer to the facility than to their nearest facility move to it
+    double delta = instance.cost(facility);
+    const double *row = instance.getDistanceRow(facility);
+    for (size_t iC = 0; iC < nearestDistance.size(); ++iC) {
+        if (row[iC] < nearestDistance[iC]) {
+            delta += row[iC] - nearestDistance[iC];
+        }
+    }
+    return delta;
+}
+
+template<size_t NF>
+void FacilityLocation::IncrementalEvaluator<NF>::flip(size_t facility) {
+    assert(facility < instance.getNumberFacility());
+    const size_t numberCustomer = instance.getNumberCustomer();
+    solution.flip(facility);
+    if (solution[facility] ? openCount == 0 : openCount == 1) {
+        // The score goes from or to INFINITY
+        this->reset(Individual(solution));
+        return;
+    }
+
+    if (solution[facility]) {
+        ++openCount;
+        score += instance.cost(facility);
+        const double *row = instance.getDistanceRow(facility);
+        for (size_t iC = 0; iC < numberCustomer; ++iC) {
+            if (row[iC] < nearestDistance[iC]) {
+                score += row[iC] - nearestDistance[iC];
+                this->detach(iC);
+                secondNearest[iC] = nearest[iC];
+                secondDistance[iC] = nearestDistance[iC];
+                nearest[iC] = facility;
+                nearestDistance[iC] = row[iC];
+                this->attach(iC, facility);
+            } else if (row[iC] < secondDistance[iC]) {
+                secondNearest[iC] = facility;
+                secondDistance[iC] = row[iC];
+            }
+        }
+    } else {
+        --openCount;
+        score -= instance.cost(facility);
+        std::vector<size_t> customers;
+        customers.swap(served[facility]);
+        for (size_t iC: customers) {
+            score += secondDistance[iC] - nearestDistance[iC];
+            nearest[iC] = secondNearest[iC];
+            nearestDistance[iC] = secondDistance[iC];
+            this->attach(iC, nearest[iC]);
+            this->updateSecondNearest(iC);
+        }
+        for (size_t iC = 0; iC < numberCustomer; ++iC) {
+            if (secondNearest[iC] == facility) {
+                this->updateSecondNearest(iC);
+            }
+        }
+    }
+}
+
+template<size_t NF>
+size_t FacilityLocation::IncrementalEvaluator<NF>::countDifferences(const Individual &individual) const {
+    assert(individual.size() == solution.size());
+    size_t result = 0;
+    for (size_t w = 0; w < solution.getWordCount(); ++w) {
+        result += (size_t) __builtin_popcountll(individual.getWord(w) ^ solution.getWord(w));
+    }
+    return result;
+}
+
+template<size_t NF>
+double FacilityLocation::IncrementalEvaluator<NF>::evaluate(const Individual &individual,
+                                                             FacilityLocation::InstructionSet instructionSet) const {
+    assert(individual.size() == solution.size());
+    if (openCount == 0 || individual.none()) {
+        // Nothing to start from, or nothing open
+        double result = 0.;
+        for (size_t iF = 0; iF < instance.getNumberFacility(); ++iF) {
+            if (individual[iF]) {
+                result += instance.cost(iF);
+            }
+        }
+        for (size_t iC = 0; iC < nearest.size(); ++iC) {
+            result += this->getNearestDistance(individual, iC);
+        }
+        return result;
+    }
+
+    // Opening costs in the order of the facilities, as the objective sums them
+    double result = 0.;
+    std::vector<const double *> openedRows;
+    std::vector<size_t> closed;
+    for (size_t w = 0; w < solution.getWordCount(); ++w) {
+        for (uint64_t open = individual.getWord(w); open != 0; open &= open - 1) {
+            result += instance.cost(64 * w + (size_t) __builtin_ctzll(open));
+        }
+        uint64_t changes = individual.getWord(w) ^ solution.getWord(w);
+        while (changes != 0) {
+            const size_t iF = 64 * w + (size_t) __builtin_ctzll(changes);
+            changes &= changes - 1;
+            if (individual[iF]) {
+                openedRows.push_back(instance.getDistanceRow(iF));
+            } else {
+                closed.push_back(iF);
+            }
+        }
+    }
+
+    // Distances of the reference solution, updated for the customers of closed facilities
+    std::vector<double> distances(nearestDistance);
+    for (size_t iF: closed) {
+        for (size_t iC: served[iF]) {
+            distances[iC] = secondNearest[iC] != none && individual[secondNearest[iC]]
+                            ? secondDistance[iC] : this->getNearestDistance(individual, iC);
+        }
+    }
+    if (!openedRows.empty()) {
+        Kernel::minimum(instructionSet, openedRows.data(), openedRows.size(), distances.size(), distances.data());
+    }
+    // Then the distances in the order of the customers, for the score to be exactly the one of the objective
+    for (size_t iC = 0; iC < distances.size(); ++iC) {
+        result += distances[iC];
+    }
+    return result;
+}
+
+template<size_t NF>
+double FacilityLocation::IncrementalEvaluator<NF>::getNearestDistance(const Individual &individual,
+                                                                      size_t customer) const {
+    double result = INFINITY;
+    for (size_t iF = 0; iF < instance.getNumberFacility(); ++iF) {
+        if (individual[iF] && instance.distance(iF, customer) < result) {
+            result = instance.distance(iF, customer);
+        }
+    }
+    return result;
+}
+
+template<size_t NF>
+void FacilityLocation::IncrementalEvaluator<NF>::updateSecondNearest(size_t customer) {
+    secondNearest[customer] = none;
+    secondDistance[customer] = INFINITY;
+    for (size_t iF = 0; iF < instance.getNumberFacility(); ++iF) {
+        if (solution[iF] && iF != nearest[customer] && instance.distance(iF, customer) < secondDistance[customer]) {
+            secondNearest[customer] = iF;
+            secondDistance[customer] = instance.distance(iF, customer);
+        }
+    }
+}
+
+template<size_t NF>
+void FacilityLocation::IncrementalEvaluator<NF>::attach(size_t customer, size_t facility) {
+    servedPosition[customer] = served[facility].size();
+    served[facility].push_back(customer);
+}
+
+template<size_t NF>
+void FacilityLocation::IncrementalEvaluator<NF>::detach(size_t customer) {
+    std::vector<size_t> &customers = served[nearest[customer]];
+    const size_t last = customers.back();
+    customers[servedPosition[customer]] = last;
+    servedPosition[last] = servedPosition[customer];
+    customers.pop_back();
+}
@@ -1,8 +1,16 @@
-#include <algorithm> // swap
+#include <algorithm> // copy, fill, max, min, partial_sort, swap
 #include <cassert>
-#include <cstdlib> // size_t
-#include <cmath> // sqrt, INFINITY
+#include <cstdlib> // free, posix_memalign, size_t
+#include <cstring> // memcpy, memset
+#include <cmath> // fabs, ldexp, lround, sqrt, INFINITY
+#include <new> // bad_alloc
 #include <random>
+#include <stdexcept> // runtime_error
+#include <string>
+#include <fcntl.h> // open
+#include <sys/mman.h> // madvise, mmap
+#include <sys/stat.h> // fstat
+#include <unistd.h> // close
 
 #include <array>
 #include <bitset>
@@ -10,19 +18,29 @@
 #include <FacilityLocation/Instance.h>
 #include <iostream>
 
+template<size_t NF>
+constexpr uint64_t FacilityLocation::Instance<NF>::magic;
+
+template<size_t NF>
+constexpr uint64_t FacilityLocation::Instance<NF>::version;
+
+template<size_t NF>
+constexpr size_t FacilityLocation::Instance<NF>::headerSize;
+
 template<size_t NF>
 FacilityLocation::Instance<NF>
-FacilityLocation::Instance<NF>::randomInstance(size_t numberCustomer, unsigned int seed) {
+FacilityLocation::Instance<NF>::randomInstance(size_t numberCustomer, unsigned int seed,
+        size_t numberFacility) {
     std::default_random_engine rnd(seed);
     std::uniform_real_distribution<double> distrib(0., 1.);
 
-    Instance out(numberCustomer);
+    assert(numberFacility != 0 && (NF == 0 || numberFacility == NF));
+    Instance out(numberFacility, numberCustomer);
     // iF for index of the facility
     for (size_t iF = 0; iF < numberFacility; ++iF) {
-        out.distances[iF] = new double[numberCustomer];
         // iC for index of customer
         for (size_t iC = 0; iC < numberCustomer; ++iC) {
-            out.distances[iF][iC] = distrib(rnd);
+            out.setDistance(out.getIndex(iF, iC), distrib(rnd));
         }
     }
     for (size_t iF = 0; iF < numberFacility; ++iF) {
@@ -33,13 +51,15 @@ FacilityLocation::Instance<NF>::randomInstance(size_t numberCustomer, unsigned i
 
 template<size_t NF>
 FacilityLocation::Instance<NF>
-FacilityLocation::Instance<NF>::randomMetricInstance(size_t numberCustomer, unsigned int seed, bool ordered) {
+FacilityLocation::Instance<NF>::randomMetricInstance(size_t numberCustomer, unsigned int seed, bool ordered,
+        size_t numberFacility) {
     std::default_random_engine rnd(seed);
     std::uniform_real_distribution<double> distrib(0., 1.);
     /*
      * We associate a 2D position to each customer and facility, and then convert to distances
      */
-    Instance out(numberCustomer);
+    assert(numberFacility != 0 && (NF == 0 || numberFacility == NF));
+    Instance out(numberFacility, numberCustomer);
 
     using Coordinate = std::pair<double, double>;
     std::vector<Coordinate> customerPosition;
@@ -58,12 +78,11 @@ FacilityLocation::Instance<NF>::randomMetricInstance(size_t numberCustomer, unsi
     double x, y;
     // iF for index of facility
     for (size_t iF = 0; iF < numberFacility; ++iF) {
-        out.distances[iF] = new double[numberCustomer];
         // iC for index of customer
         for (size_t iC = 0; iC < numberCustomer; ++iC) {
-            x = facilityPosition[iC].first - customerPosition[iF].first;
-            y = facilityPosition[iC].second - customerPosition[iF].second;
-            out.distances[iF][iC] = sqrt(x * x + y * y);
+            x = facilityPosition[iF].first - customerPosition[iC].first;
+            y = facilityPosition[iF].second - customerPosition[iC].second;
+            out.setDistance(out.getIndex(iF, iC), sqrt(x * x + y * y));
         }
     }
 
@@ -75,7 +94,8 @@ FacilityLocation::Instance<NF>::randomMetricInstance(size_t numberCustomer, unsi
 
 template<size_t NF>
 FacilityLocation::Instance<NF>
-FacilityLocation::Instance<NF>::randomFlawedMetricInstance(size_t numberCustomer, unsigned int seed, bool ordered) {
+FacilityLocation::Instance<NF>::randomFlawedMetricInstance(size_t numberCustomer, unsigned int seed, bool ordered,
+        size_t numberFacility) {
     std::default_random_engine rnd(seed);
     constexpr int N = 3; // Number of subdivision on each coordinate
     std::uniform_real_distribution<double> distrib(0., 1./N);
@@ -93,7 +113,8 @@ FacilityLocation::Instance<NF>::randomFlawedMetricInstance(size_t numberCustomer
     /*
      * We associate a 2D position to each customer and facility, and then convert to distances
      */
-    Instance out(numberCustomer);
+    assert(numberFacility != 0 && (NF == 0 || numberFacility == NF));
+    Instance out(numberFacility, numberCustomer);
 
     using Coordinate = std::pair<double, double>;
     std::vector<Coordinate> customerPosition;
@@ -114,12 +135,11 @@ FacilityLocation::Instance<NF>::randomFlawedMetricInstance(size_t numberCustomer
     double x, y;
     // iF for index of facility
     for (size_t iF = 0; iF < numberFacility; ++iF) {
-        out.distances[iF] = new double[numberCustomer];
         // iC for index of customer
         for (size_t iC = 0; iC < numberCustomer; ++iC) {
-            x = facilityPosition[iC].first - customerPosition[iF].first;
-            y = facilityPosition[iC].second - customerPosition[iF].second;
-            out.distances[iF][iC] = sqrt(x * x + y * y);
+            x = facilityPosition[iF].first - customerPosition[iC].first;
+            y = facilityPosition[iF].second - customerPosition[iC].second;
+            out.setDistance(out.getIndex(iF, iC), sqrt(x * x + y * y));
         }
     }
 
@@ -130,40 +150,56 @@ FacilityLocation::Instance<NF>::randomFlawedMetricInstance(size_t numberCustomer
 }
 
 template<size_t NF>
-FacilityLocation::Instance<NF> FacilityLocation::Instance<NF>::load(std::string filename) {
-    // TODO: safe loading, no check are done
+FacilityLocation::Instance<NF> FacilityLocation::Instance<NF>::load(std::string filename, bool verify) {
+    std::ifstream file(filename, std::ios::binary);
+    uint64_t first = 0;
+    if (!file || !file.read(reinterpret_cast<char *>(&first), sizeof(first))) {
+        throw std::runtime_error("Can't read instance " + filename);
+    }
+    file.close();
+    return first == magic ? loadBinary(filename, verify) : loadText(filename);
+}
+
+template<size_t NF>
+FacilityLocation::Instance<NF> FacilityLocation::Instance<NF>::loadText(const std::string &filename) {
     std::ifstream file(filename);
     std::string str;
-    size_t numberFacility, numberCustomer;
+    size_t numberFacility = 0, numberCustomer = 0;
     double input;
+    auto fail = [&filename](const std::string &reason) {
+        return std::runtime_error("Invalid instance " + filename + ": " + reason);
+    };
 
-    file >> str;
-    assert(str == "Size:");
-    file >> numberFacility;
-    assert(numberFacility == NF);
-    file >> numberCustomer;
-
-    FacilityLocation::Instance<NF> instance(numberCustomer);
-    for (size_t iF = 0; iF < numberFacility; ++iF) {
-        instance.distances[iF] = new double[numberCustomer];
+    if (!(file >> str) || str != "Size:" || !(file >> numberFacility >> numberCustomer)) {
+        throw fail("expected Size: followed by the numbers of facilities and customers");
     }
+    if (numberFacility == 0 || (NF != 0 && numberFacility != NF)) {
+        throw fail(std::to_string(numberFacility) + " facilities"
+                   + (NF != 0 ? ", " + std::to_string(NF) + " expected" : ""));
+    }
+
+    FacilityLocation::Instance<NF> instance(numberFacility, numberCustomer);
 
-    file >> str;
-    assert(str == "Distances:");
+    if (!(file >> str) || str != "Distances:") {
+        throw fail("expected Distances:");
+    }
     for (size_t i = 0; i < numberFacility; ++i) {
         for (size_t j = 0; j < numberCustomer; ++j) {
-            file >> input;
-            instance.distances[i][j] = input;
+            if (!(file >> input) || !(input >= 0.)) {
+                throw fail("distance " + std::to_string(i) + " " + std::to_string(j) + " is not a non-negative number");
+            }
+            instance.setDistance(instance.getIndex(i, j), input);
         }
     }
 
-
-    file >> str;
-    assert(str == "Opening");
-    file >> str;
-    assert(str == "costs:");
+    std::string str2;
+    if (!(file >> str >> str2) || str != "Opening" || str2 != "costs:") {
+        throw fail("expected Opening costs:");
+    }
     for (size_t i = 0; i < numberFacility; ++i) {
-        file >> input;
+        if (!(file >> input) || !(input >= 0.)) {
+            throw fail("opening cost " + std::to_string(i) + " is not a non-negative number");
+        }
         instance.openingCost[i] = input;
     }
 
@@ -171,6 +207,108 @@ FacilityLocation::Instance<NF> FacilityLocation::Instance<NF>::load(std::string
     return instance;
 }
 
+template<size_t NF>
+FacilityLocation::Instance<NF> FacilityLocation::Instance<NF>::loadBinary(const std::string &filename, bool verify) {
+    auto fail = [&filename](const std::string &reason) {
+        return std::runtime_error("Invalid instance " + filename + ": " + reason);
+    };
+
+    const int descriptor = ::open(filename.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        throw std::runtime_error("Can't open instance " + filename);
+    }
+    struct stat status;
+    if (fstat(descriptor, &status) != 0 || (size_t) status.st_size < headerSize) {
+        ::close(descriptor);
+        throw fail("truncated header");
+    }
+    const size_t size = (size_t) status.st_size;
+    void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    ::close(descriptor);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Can't map instance " + filename);
+    }
+
+    // Validate the header before trusting any of its sizes
+    uint64_t header[11];
+    std::memcpy(header, mapping, sizeof(header));
+    const char *error = nullptr;
+    if (header[0] != magic) {
+        error = "not a binary instance";
+    } else if (header[1] != version) {
+        error = "unsupported version";
+    } else if (checksum(header, 10 * sizeof(uint64_t)) != header[10]) {
+        error = "corrupted header";
+    } else if (header[2] == 0 || (NF != 0 && header[2] != NF)) {
+        error = "wrong number of facilities";
+    } else if (header[4] > (uint64_t) Precision::Fixed16 || header[5] > (uint64_t) Layout::Blocked) {
+        error = "unknown precision or layout";
+    } else if ((Layout) header[5] == Layout::Blocked && (header[6] == 0 || header[6] % 32 != 0)) {
+        error = "invalid block size";
+    } else if (header[2] > size || header[3] > size) {
+        error = "sizes larger than the file";
+    } else if ((Layout) header[5] == Layout::Blocked
+               && header[6] > std::max<uint64_t>((header[3] + 31) / 32 * 32, 32)) {
+        error = "block size larger than the customers";
+    }
+
+    // Sizes are at most the one of the file, so only the products may overflow
+    size_t distanceBytes = 0;
+    if (error == nullptr) {
+        const size_t numberFacility = header[2], numberCustomer = header[3], blockSize = header[6];
+        const size_t distanceSize = header[4] == (uint64_t) Precision::Double ? sizeof(double)
+                                  : header[4] == (uint64_t) Precision::Float ? sizeof(float) : sizeof(uint16_t);
+        const size_t line = 64 / distanceSize;
+        size_t rows = 0, rowLength = 0, expected = 0;
+        switch ((Layout) header[5]) {
+            case Layout::FacilityMajor:
+                rows = numberFacility;
+                rowLength = (numberCustomer + line - 1) / line * line;
+                break;
+            case Layout::CustomerMajor:
+                rows = numberCustomer;
+                rowLength = (numberFacility + line - 1) / line * line;
+                break;
+            case Layout::Blocked:
+                rows = (numberCustomer + blockSize - 1) / blockSize;
+                rowLength = blockSize;
+                if (__builtin_mul_overflow(rows, numberFacility, &rows)) {
+                    error = "sizes too large";
+                }
+                break;
+        }
+        if (error == nullptr && (__builtin_mul_overflow(rows, rowLength, &distanceBytes)
+                                 || __builtin_mul_overflow(distanceBytes, distanceSize, &distanceBytes)
+                                 || __builtin_mul_overflow(numberFacility, sizeof(double), &expected)
+                                 || __builtin_add_overflow(expected, distanceBytes, &expected)
+                                 || __builtin_add_overflow(expected, headerSize, &expected))) {
+            error = "sizes too large";
+        } else if (error == nullptr && size != expected) {
+            error = "size of the file does not match its header";
+        }
+    }
+    if (error != nullptr) {
+        munmap(mapping, size);
+        throw fail(error);
+    }
+
+    // The instance owns the mapping from now on, and unmaps it if an exception is thrown
+    Instance instance(header[2], header[3], (Layout) header[5], (size_t) header[6], (Precision) header[4],
+                      mapping, size);
+    assert(instance.distanceCount * instance.getDistanceSize() == distanceBytes);
+    std::memcpy(&instance.distanceStep, header + 7, sizeof(double));
+    std::memcpy(&instance.costStep, header + 8, sizeof(double));
+    if (instance.precision == Precision::Fixed16 && !(instance.distanceStep > 0. && instance.costStep > 0.)) {
+        throw fail("invalid fixed-point steps");
+    }
+    std::memcpy(instance.openingCost, static_cast<const char *>(mapping) + headerSize + distanceBytes,
+                instance.numberFacility * sizeof(double));
+    if (verify && instance.getDataChecksum() != header[9]) {
+        throw fail("corrupted distances or opening costs");
+    }
+    return instance;
+}
+
 template<size_t NF>
 std::vector<std::pair<double, double>> FacilityLocation::Instance<NF>::orderPositions(std::vector<std::pair<double, double>> input) {
     std::vector<std::pair<double, double>> result;
@@ -201,41 +339,126 @@ std::vector<std::pair<double, double>> FacilityLocation::Instance<NF>::orderPosi
 }
 
 template<size_t NF>
-FacilityLocation::Instance<NF>::Instance(size_t numberCustomer) : numberCustomer(numberCustomer) {}
-
-template<size_t NF>
-FacilityLocation::Instance<NF>::Instance(const FacilityLocation::Instance<NF> &instance) :
-        numberCustomer(instance.numberCustomer) {
-    // iF for index of the facility
-    for (size_t iF = 0; iF < this->numberFacility; ++iF) {
-        this->distances[iF] = new double[this->numberCustomer];
-        // iC for index of customer
-        for (size_t iC = 0; iC < this->numberCustomer; ++iC) {
-            this->distances[iF][iC] = instance.distances[iF][iC];
+FacilityLocation::Instance<NF>::Instance(size_t numberFacility, size_t numberCustomer,
+                                         FacilityLocation::Layout layout, size_t blockSize,
+                                         FacilityLocation::Precision precision, void *mapping, size_t mappingSize) :
+        numberFacility(numberFacility),
+        numberCustomer(numberCustomer),
+        layout(layout),
+        blockSize(0),
+        rowStride(0),
+        blockStride(0),
+        distanceCount(0),
+        precision(precision),
+        distanceStep(0.),
+        costStep(0.),
+        distances(nullptr),
+        mapping(nullptr),
+        mappingSize(0),
+        openingCost(nullptr),
+        candidateCount(0) {
+    this->setShape(blockSize);
+    // The destructor does not run if the constructor throws, so the mapping is owned once nothing can
+    try {
+        openingCost = new double[numberFacility];
+    } catch (...) {
+        if (mapping != nullptr) {
+            munmap(mapping, mappingSize);
         }
+        throw;
     }
-    for (size_t iF = 0; iF < this->numberFacility; ++iF) {
-        this->openingCost[iF] = instance.openingCost[iF];
+    if (mapping != nullptr) {
+        this->mapping = mapping;
+        this->mappingSize = mappingSize;
+        distances = static_cast<char *>(mapping) + headerSize;
+    } else {
+        try {
+            distances = allocate(distanceCount * this->getDistanceSize());
+        } catch (...) {
+            delete[] openingCost;
+            throw;
+        }
+        // Padding included, for copies to be bulk copies of initialized memory
+        std::memset(distances, 0, distanceCount * this->getDistanceSize());
+    }
+}
+
+template<size_t NF>
+void FacilityLocation::Instance<NF>::setShape(size_t blockSize) {
+    // Rows are padded to a cache line of 64 bytes
+    const size_t line = 64 / this->getDistanceSize();
+    switch (layout) {
+        case Layout::FacilityMajor:
+            this->blockSize = numberCustomer;
+            rowStride = (numberCustomer + line - 1) / line * line;
+            blockStride = numberFacility * rowStride;
+            distanceCount = blockStride;
+            break;
+        case Layout::CustomerMajor:
+            this->blockSize = 1;
+            rowStride = 1;
+            blockStride = (numberFacility + line - 1) / line * line;
+            distanceCount = numberCustomer * blockStride;
+            break;
+        case Layout::Blocked:
+            this->blockSize = blockSize != 0 ? blockSize : getDefaultBlockSize(numberFacility);
+            // A block needs not be larger than the customers rounded to 32, which loadBinary relies on
+            this->blockSize = std::min(this->blockSize, std::max<size_t>((numberCustomer + 31) / 32 * 32, 32));
+            assert(this->blockSize % line == 0);
+            rowStride = this->blockSize;
+            blockStride = numberFacility * rowStride;
+            distanceCount = (numberCustomer + this->blockSize - 1) / this->blockSize * blockStride;
+            break;
     }
 }
 
 template<size_t NF>
-FacilityLocation::Instance<NF>::Instance(FacilityLocation::Instance<NF> &&instance) : numberCustomer(
-        instance.numberCustomer) {
+FacilityLocation::Instance<NF>::Instance(const FacilityLocation::Instance<NF> &instance) :
+        Instance(instance.numberFacility, instance.numberCustomer, instance.layout, instance.blockSize,
+                 instance.precision) {
+    distanceStep = instance.distanceStep;
+    costStep = instance.costStep;
+    std::memcpy(this->distances, instance.distances, distanceCount * this->getDistanceSize());
+    std::copy(instance.openingCost, instance.openingCost + numberFacility, this->openingCost);
+    candidateCount = instance.candidateCount;
+    candidates = instance.candidates;
+    candidateDistances = instance.candidateDistances;
+}
+
+template<size_t NF>
+FacilityLocation::Instance<NF>::Instance(FacilityLocation::Instance<NF> &&instance) :
+        numberFacility(instance.numberFacility),
+        numberCustomer(instance.numberCustomer),
+        layout(Layout::FacilityMajor),
+        blockSize(0),
+        rowStride(0),
+        blockStride(0),
+        distanceCount(0),
+        precision(Precision::Double),
+        distanceStep(0.),
+        costStep(0.),
+        distances(nullptr),
+        mapping(nullptr),
+        mappingSize(0),
+        openingCost(nullptr),
+        candidateCount(0) {
     swap(*this, instance);
 }
 
 template<size_t NF>
 FacilityLocation::Instance<NF>::~Instance() {
-    for (size_t i = 0; i < numberFacility; ++i) {
-        delete[] distances[i];
+    if (mapping != nullptr) {
+        munmap(mapping, mappingSize);
+    } else {
+        std::free(distances);
     }
+    delete[] openingCost;
 }
 
 template<size_t NF>
 FacilityLocation::Instance<NF> &
 FacilityLocation::Instance<NF>::operator=(const FacilityLocation::Instance<NF> &instance) {
-    Instance &copy = FacilityLocation::Instance<NF>(instance);
+    Instance copy(instance);
     swap(*this, copy);
     return *this;
 }
@@ -260,7 +483,16 @@ template<size_t NF>
 double FacilityLocation::Instance<NF>::distance(size_t facility, size_t customer) const {
     assert(facility < numberFacility);
     assert(customer < numberCustomer);
-    return distances[facility][customer];
+    const size_t index = this->getIndex(facility, customer);
+    switch (precision) {
+        case Precision::Double:
+            return static_cast<const double *>(distances)[index];
+        case Precision::Float:
+            return static_cast<const float *>(distances)[index];
+        case Precision::Fixed16:
+            return static_cast<const uint16_t *>(distances)[index] * distanceStep;
+    }
+    return 0.;
 }
 
 template<size_t NF>
@@ -269,28 +501,251 @@ double FacilityLocation::Instance<NF>::cost(size_t facility) const {
     return openingCost[facility];
 }
 
+template<size_t NF>
+FacilityLocation::Layout FacilityLocation::Instance<NF>::getLayout() const {
+    return layout;
+}
+
+template<size_t NF>
+void FacilityLocation::Instance<NF>::setLayout(FacilityLocation::Layout layout, size_t blockSize) {
+    Instance result(numberFacility, numberCustomer, layout, blockSize, precision);
+    result.distanceStep = distanceStep;
+    result.costStep = costStep;
+    result.copyValues(*this);
+    // Distances are unchanged, and so are their nearest facilities
+    std::swap(result.candidateCount, candidateCount);
+    std::swap(result.candidates, candidates);
+    std::swap(result.candidateDistances, candidateDistances);
+    swap(*this, result);
+}
+
+template<size_t NF>
+size_t FacilityLocation::Instance<NF>::getBlockSize() const {
+    return blockSize;
+}
+
+template<size_t NF>
+FacilityLocation::Precision FacilityLocation::Instance<NF>::getPrecision() const {
+    return precision;
+}
+
+template<size_t NF>
+void FacilityLocation::Instance<NF>::setPrecision(FacilityLocation::Precision precision) {
+    Instance result(numberFacility, numberCustomer, layout, layout == Layout::Blocked ? blockSize : 0, precision);
+    if (precision == Precision::Fixed16) {
+        double maxDistance = 0.;
+        for (size_t iF = 0; iF < numberFacility; ++iF) {
+            for (size_t iC = 0; iC < numberCustomer; ++iC) {
+                maxDistance = std::max(maxDistance, this->distance(iF, iC));
+            }
+        }
+        const double maxCost = *std::max_element(openingCost, openingCost + numberFacility);
+        result.distanceStep = maxDistance > 0. ? maxDistance / 65535. : 1.;
+        result.costStep = maxCost > 0. ? maxCost / 65535. : 1.;
+    }
+    result.copyValues(*this);
+    swap(*this, result);
+    // Rounding may change the order of the nearest facilities
+    this->setCandidateCount(result.candidateCount);
+}
+
+template<size_t NF>
+double FacilityLocation::Instance<NF>::getDistanceStep() const {
+    return precision == Precision::Fixed16 ? distanceStep : 0.;
+}
+
+template<size_t NF>
+double FacilityLocation::Instance<NF>::getErrorBound(double score, size_t openCount) const {
+    switch (precision) {
+        case Precision::Double:
+            return 0.;
+        case Precision::Float:
+            // Twice the bound of the roundings, for the score to be the rounded one
+            return std::ldexp(std::fabs(score), -23);
+        case Precision::Fixed16:
+            return ((double) numberCustomer * distanceStep + (double) openCount * costStep) / 2.;
+    }
+    return 0.;
+}
+
+template<size_t NF>
+template<class Distance>
+const Distance *FacilityLocation::Instance<NF>::getDistanceRow(size_t facility, size_t customer) const {
+    assert(sizeof(Distance) == this->getDistanceSize());
+    assert(facility < numberFacility);
+    assert(customer < numberCustomer || customer == 0);
+    return static_cast<const Distance *>(distances) + this->getIndex(facility, customer);
+}
+
+template<size_t NF>
+template<class Distance>
+const Distance *FacilityLocation::Instance<NF>::getDistanceColumn(size_t customer) const {
+    assert(sizeof(Distance) == this->getDistanceSize());
+    assert(layout == Layout::CustomerMajor);
+    assert(customer < numberCustomer);
+    return static_cast<const Distance *>(distances) + this->getIndex(0, customer);
+}
+
+template<size_t NF>
+void FacilityLocation::Instance<NF>::setCandidateCount(size_t candidateCount) {
+    assert(numberFacility <= UINT32_MAX);
+    this->candidateCount = std::min(candidateCount, numberFacility);
+    candidates.assign(numberCustomer * this->candidateCount, 0);
+    candidateDistances.assign(numberCustomer * this->candidateCount, 0.);
+    if (this->candidateCount == 0) {
+        candidates.shrink_to_fit();
+        candidateDistances.shrink_to_fit();
+        return;
+    }
+    std::vector<std::pair<double, uint32_t>> nearest(numberFacility);
+    const auto last = nearest.begin() + (std::ptrdiff_t) this->candidateCount;
+    for (size_t iC = 0; iC < numberCustomer; ++iC) {
+        for (size_t iF = 0; iF < numberFacility; ++iF) {
+            nearest[iF] = std::make_pair(this->distance(iF, iC), (uint32_t) iF);
+        }
+        std::partial_sort(nearest.begin(), last, nearest.end());
+        for (size_t k = 0; k < this->candidateCount; ++k) {
+            candidates[iC * this->candidateCount + k] = nearest[k].second;
+            candidateDistances[iC * this->candidateCount + k] = nearest[k].first;
+        }
+    }
+}
+
+template<size_t NF>
+size_t FacilityLocation::Instance<NF>::getCandidateCount() const {
+    return candidateCount;
+}
+
+template<size_t NF>
+const uint32_t *FacilityLocation::Instance<NF>::getCandidates(size_t customer) const {
+    assert(customer < numberCustomer);
+    return candidates.data() + customer * candidateCount;
+}
+
+template<size_t NF>
+const double *FacilityLocation::Instance<NF>::getCandidateDistances(size_t customer) const {
+    assert(customer < numberCustomer);
+    return candidateDistances.data() + customer * candidateCount;
+}
+
+template<size_t NF>
+size_t FacilityLocation::Instance<NF>::getDistanceSize() const {
+    switch (precision) {
+        case Precision::Double:
+            return sizeof(double);
+        case Precision::Float:
+            return sizeof(float);
+        case Precision::Fixed16:
+            return sizeof(uint16_t);
+    }
+    return 0;
+}
+
+template<size_t NF>
+void FacilityLocation::Instance<NF>::setDistance(size_t index, double value) {
+    assert(index < distanceCount);
+    switch (precision) {
+        case Precision::Double:
+            static_cast<double *>(distances)[index] = value;
+            break;
+        case Precision::Float:
+            static_cast<float *>(distances)[index] = (float) value;
+            break;
+        case Precision::Fixed16:
+            assert(value >= 0. && value <= 65535.5 * distanceStep);
+            static_cast<uint16_t *>(distances)[index] = (uint16_t) std::lround(value / distanceStep);
+            break;
+    }
+}
+
+template<size_t NF>
+void FacilityLocation::Instance<NF>::copyValues(const FacilityLocation::Instance<NF> &instance) {
+    assert(instance.numberFacility == numberFacility && instance.numberCustomer == numberCustomer);
+    for (size_t iF = 0; iF < numberFacility; ++iF) {
+        for (size_t iC = 0; iC < numberCustomer; ++iC) {
+            this->setDistance(this->getIndex(iF, iC), instance.distance(iF, iC));
+        }
+    }
+    for (size_t iF = 0; iF < numberFacility; ++iF) {
+        switch (precision) {
+            case Precision::Double:
+                openingCost[iF] = instance.openingCost[iF];
+                break;
+            case Precision::Float:
+                openingCost[iF] = (float) instance.openingCost[iF];
+                break;
+            case Precision::Fixed16:
+                openingCost[iF] = (double) std::lround(instance.openingCost[iF] / costStep) * costStep;
+                break;
+        }
+    }
+}
+
+template<size_t NF>
+size_t FacilityLocation::Instance<NF>::getIndex(size_t facility, size_t customer) const {
+    switch (layout) {
+        case Layout::FacilityMajor:
+            return facility * rowStride + customer;
+        case Layout::CustomerMajor:
+            return customer * blockStride + facility;
+        case Layout::Blocked:
+            break;
+    }
+    return customer / blockSize * blockStride + facility * rowStride + customer % blockSize;
+}
+
+template<size_t NF>
+void *FacilityLocation::Instance<NF>::allocate(size_t size) {
+    size = std::max<size_t>(size, 64);
+    const size_t hugePage = size_t(1) << 21;
+    const size_t alignment = size >= 2 * hugePage ? hugePage : 64;
+    void *memory = nullptr;
+    if (posix_memalign(&memory, alignment, size) != 0) {
+        throw std::bad_alloc();
+    }
+#ifdef MADV_HUGEPAGE
+    if (alignment == hugePage) {
+        // Only a hint, transparent huge pages may be disabled
+        madvise(memory, size, MADV_HUGEPAGE);
+    }
+#endif
+    return memory;
+}
+
 template<size_t NF>
 void FacilityLocation::swap(FacilityLocation::Instance<NF> &first, FacilityLocation::Instance<NF> &second) {
-    assert(first.numberCustomer == second.numberCustomer);
     using std::swap;
-//    swap(first.numberFacility, second.numberFacility);
-//    swap(first.numberCustomer, second.numberCustomer);
+    swap(first.numberFacility, second.numberFacility);
+    swap(first.numberCustomer, second.numberCustomer);
+    swap(first.layout, second.layout);
+    swap(first.blockSize, second.blockSize);
+    swap(first.rowStride, second.rowStride);
+    swap(first.blockStride, second.blockStride);
+    swap(first.distanceCount, second.distanceCount);
+    swap(first.precision, second.precision);
+    swap(first.distanceStep, second.distanceStep);
+    swap(first.costStep, second.costStep);
     swap(first.distances, second.distances);
+    swap(first.mapping, second.mapping);
+    swap(first.mappingSize, second.mappingSize);
     swap(first.openingCost, second.openingCost);
+    swap(first.candidateCount, second.candidateCount);
+    swap(first.candidates, second.candidates);
+    swap(first.candidateDistances, second.candidateDistances);
 }
 
 template<size_t NF>
 void FacilityLocation::Instance<NF>::save(std::string filename) const {
     std::ofstream file(filename);
-    file << "Size: " << numberFacility << "\t" << numberCustomer << std::endl;
-    file << "Distances: " << std::endl;
+    file << "Size: " << numberFacility << "\t" << numberCustomer << "\n";
+    file << "Distances: " << "\n";
     for (size_t i = 0; i < numberFacility; ++i) {
         for (size_t j = 0; j < numberCustomer; ++j) {
             file << distance(i, j) << "\t";
         }
-        file << std::endl;
+        file << "\n";
     }
-    file << "Opening costs: " << std::endl;
+    file << "Opening costs: " << "\n";
     for (size_t i = 0; i < numberFacility; ++i) {
         file << cost(i) << "\t";
     }
@@ -298,3 +753,51 @@ void FacilityLocation::Instance<NF>::save(std::string filename) const {
     file.close();
 }
 
+template<size_t NF>
+bool FacilityLocation::Instance<NF>::saveBinary(const std::string &filename) const {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file) {
+        std::cerr << "Can't open file " << filename << std::endl;
+        return false;
+    }
+    uint64_t header[headerSize / sizeof(uint64_t)] = {
+            magic, version, numberFacility, numberCustomer, (uint64_t) precision, (uint64_t) layout,
+            layout == Layout::Blocked ? blockSize : 0};
+    std::memcpy(header + 7, &distanceStep, sizeof(double));
+    std::memcpy(header + 8, &costStep, sizeof(double));
+    header[9] = this->getDataChecksum();
+    header[10] = checksum(header, 10 * sizeof(uint64_t));
+    file.write(reinterpret_cast<const char *>(header), sizeof(header));
+    file.write(static_cast<const char *>(distances), (std::streamsize) (distanceCount * this->getDistanceSize()));
+    file.write(reinterpret_cast<const char *>(openingCost), (std::streamsize) (numberFacility * sizeof(double)));
+    file.close();
+    if (!file) {
+        std::cerr << "Can't write file " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+template<size_t NF>
+bool FacilityLocation::Instance<NF>::isMapped() const {
+    return mapping != nullptr;
+}
+
+template<size_t NF>
+uint64_t FacilityLocation::Instance<NF>::checksum(const void *data, size_t size, uint64_t hash) {
+    assert(size % sizeof(uint64_t) == 0);
+    // FNV-1a on words instead of bytes
+    const char *bytes = static_cast<const char *>(data);
+    for (size_t i = 0; i < size; i += sizeof(uint64_t)) {
+        uint64_t word;
+        std::memcpy(&word, bytes + i, sizeof(word));
+        hash = (hash ^ word) * 0x100000001b3;
+    }
+    return hash;
+}
+
+template<size_t NF>
+uint64_t FacilityLocation::Instance<NF>::getDataChecksum() const {
+    const uint64_t hash = checksum(distances, distanceCount * this->getDistanceSize());
+    return checksum(openingCost, numberFacility * sizeof(double), hash);
+}
@@ -0,0 +1,278 @@
+#include <cassert>
+#include <FacilityLocation/Kernel.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define FACILITYLOCATION_KERNEL_X86
+#include <immintrin.h>
+#endif
+
+inline bool FacilityLocation::Kernel::isSupported(FacilityLocation::InstructionSet instructionSet) {
+    switch (instructionSet) {
+        case InstructionSet::Scalar:
+            return true;
+#ifdef FACILITYLOCATION_KERNEL_X86
+        case InstructionSet::AVX2:
+            return __builtin_cpu_supports("avx2");
+        case InstructionSet::AVX512:
+            return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+#else
+        case InstructionSet::AVX2:
+        case InstructionSet::AVX512:
+            return false;
+#endif
+    }
+    return false;
+}
+
+inline FacilityLocation::InstructionSet FacilityLocation::Kernel::getBestInstructionSet() {
+    static const InstructionSet best = isSupported(InstructionSet::AVX512) ? InstructionSet::AVX512
+                                     : isSupported(InstructionSet::AVX2) ? InstructionSet::AVX2
+                                     : InstructionSet::Scalar;
+    return best;
+}
+
+inline const char *FacilityLocation::Kernel::getName(FacilityLocation::InstructionSet instructionSet) {
+    switch (instructionSet) {
+        case InstructionSet::Scalar:
+            return "Scalar";
+        case InstructionSet::AVX2:
+            return "AVX2";
+        case InstructionSet::AVX512:
+            return "AVX512";
+    }
+    return "";
+}
+
+template<class Distance>
+void FacilityLocation::Kernel::minimum(const Distance *const *rows, size_t rowCount, size_t length,
+                                       Distance *minimums) {
+    minimum(getBestInstructionSet(), rows, rowCount, length, minimums);
+}
+
+template<class Distance>
+void FacilityLocation::Kernel::minimum(FacilityLocation::InstructionSet instructionSet,
+                                       const Distance *const *rows, size_t rowCount, size_t length,
+                                       Distance *minimums) {
+    assert(isSupported(instructionSet));
+    switch (instructionSet) {
+        case InstructionSet::Scalar:
+            minimumScalar(rows, rowCount, length, minimums);
+            break;
+        case InstructionSet::AVX2:
+            minimumAVX2(rows, rowCount, length, minimums);
+            break;
+        case InstructionSet::AVX512:
+            minimumAVX512(rows, rowCount, length, minimums);
+            break;
+    }
+}
+
+template<class Distance>
+void FacilityLocation::Kernel::minimumScalar(const Distance *const *rows, size_t rowCount, size_t length,
+                                             Distance *minimums) {
+    for (size_t r = 0; r < rowCount; ++r) {
+        const Distance *row = rows[r];
+        for (size_t c = 0; c < length; ++c) {
+            // An unconditional store, for the compiler to vectorize the loop
+            minimums[c] = row[c] < minimums[c] ? row[c] : minimums[c];
+        }
+    }
+}
+
+/*
+ * Vector kernels keep a block of four vectors of minimums in registers while they go
+ * through every row, so that minimums are loaded and stored once per block instead of
+ * once per row. min(a, b) returns b unless a < b, as the scalar kernel does.
+ */
+
+#ifdef FACILITYLOCATION_KERNEL_X86
+
+template<>
+struct FacilityLocation::Kernel::AVX2<double> {
+    using Vector = __m256d;
+    static constexpr size_t width = 4;
+    __attribute__((target("avx2"))) static Vector load(const double *values) {
+        return _mm256_loadu_pd(values);
+    }
+    __attribute__((target("avx2"))) static void store(double *values, Vector vector) {
+        _mm256_storeu_pd(values, vector);
+    }
+    __attribute__((target("avx2"))) static Vector min(Vector a, Vector b) {
+        return _mm256_min_pd(a, b);
+    }
+};
+
+template<>
+struct FacilityLocation::Kernel::AVX2<float> {
+    using Vector = __m256;
+    static constexpr size_t width = 8;
+    __attribute__((target("avx2"))) static Vector load(const float *values) {
+        return _mm256_loadu_ps(values);
+    }
+    __attribute__((target("avx2"))) static void store(float *values, Vector vector) {
+        _mm256_storeu_ps(values, vector);
+    }
+    __attribute__((target("avx2"))) static Vector min(Vector a, Vector b) {
+        return _mm256_min_ps(a, b);
+    }
+};
+
+template<>
+struct FacilityLocation::Kernel::AVX2<uint16_t> {
+    using Vector = __m256i;
+    static constexpr size_t width = 16;
+    __attribute__((target("avx2"))) static Vector load(const uint16_t *values) {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(values));
+    }
+    __attribute__((target("avx2"))) static void store(uint16_t *values, Vector vector) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(values), vector);
+    }
+    __attribute__((target("avx2"))) static Vector min(Vector a, Vector b) {
+        return _mm256_min_epu16(a, b);
+    }
+};
+
+// Zero-masked forms, as the undefined source of the unmasked ones is reported uninitialized by GCC
+
+template<>
+struct FacilityLocation::Kernel::AVX512<double> {
+    using Vector = __m512d;
+    static constexpr size_t width = 8;
+    __attribute__((target("avx512f,avx512bw"))) static Vector load(const double *values) {
+        return _mm512_loadu_pd(values);
+    }
+    __attribute__((target("avx512f,avx512bw"))) static void store(double *values, Vector vector) {
+        _mm512_storeu_pd(values, vector);
+    }
+    __attribute__((target("avx512f,avx512bw"))) static Vector min(Vector a, Vector b) {
+        return _mm512_maskz_min_pd(__mmask8(0xff), a, b);
+    }
+};
+
+template<>
+struct FacilityLocation::Kernel::AVX512<float> {
+    using Vector = __m512;
+    static constexpr size_t width = 16;
+    __attribute__((target("avx512f,avx512bw"))) static Vector load(const float *values) {
+        return _mm512_loadu_ps(values);
+    }
+    __attribute__((target("avx512f,avx512bw"))) static void store(float *values, Vector vector) {
+        _mm512_storeu_ps(values, vector);
+    }
+    __attribute__((target("avx512f,avx512bw"))) static Vector min(Vector a, Vector b) {
+        return _mm512_maskz_min_ps(__mmask16(0xffff), a, b);
+    }
+};
+
+template<>
+struct FacilityLocation::Kernel::AVX512<uint16_t> {
+    using Vector = __m512i;
+    static constexpr size_t width = 32;
+    __attribute__((target("avx512f,avx512bw"))) static Vector load(const uint16_t *values) {
+        return _mm512_loadu_si512(values);
+    }
+    __attribute__((target("avx512f,avx512bw"))) static void store(uint16_t *values, Vector vector) {
+        _mm512_storeu_si512(values, vector);
+    }
+    __attribute__((target("avx512f,avx512bw"))) static Vector min(Vector a, Vector b) {
+        return _mm512_maskz_min_epu16(0xffffffffu, a, b);
+    }
+};
+
+template<class Distance>
+__attribute__((target("avx2")))
+void FacilityLocation::Kernel::minimumAVX2(const Distance *const *rows, size_t rowCount, size_t length,
+                                           Distance *minimums) {
+    using Operations = AVX2<Distance>;
+    using Vector = typename Operations::Vector;
+    const size_t width = Operations::width;
+    size_t c = 0;
+    for (; c + 4 * width <= length; c += 4 * width) {
+        Vector minimum0 = Operations::load(minimums + c);
+        Vector minimum1 = Operations::load(minimums + c + width);
+        Vector minimum2 = Operations::load(minimums + c + 2 * width);
+        Vector minimum3 = Operations::load(minimums + c + 3 * width);
+        for (size_t r = 0; r < rowCount; ++r) {
+            const Distance *row = rows[r] + c;
+            minimum0 = Operations::min(Operations::load(row), minimum0);
+            minimum1 = Operations::min(Operations::load(row + width), minimum1);
+            minimum2 = Operations::min(Operations::load(row + 2 * width), minimum2);
+            minimum3 = Operations::min(Operations::load(row + 3 * width), minimum3);
+        }
+        Operations::store(minimums + c, minimum0);
+        Operations::store(minimums + c + width, minimum1);
+        Operations::store(minimums + c + 2 * width, minimum2);
+        Operations::store(minimums + c + 3 * width, minimum3);
+    }
+    for (; c + width <= length; c += width) {
+        Vector minimum = Operations::load(minimums + c);
+        for (size_t r = 0; r < rowCount; ++r) {
+            minimum = Operations::min(Operations::load(rows[r] + c), minimum);
+        }
+        Operations::store(minimums + c, minimum);
+    }
+    for (; c < length; ++c) {
+        for (size_t r = 0; r < rowCount; ++r) {
+            if (rows[r][c] < minimums[c]) {
+                minimums[c] = rows[r][c];
+            }
+        }
+    }
+}
+
+template<class Distance>
+__attribute__((target("avx512f,avx512bw")))
+void FacilityLocation::Kernel::minimumAVX512(const Distance *const *rows, size_t rowCount, size_t length,
+                                             Distance *minimums) {
+    using Operations = AVX512<Distance>;
+    using Vector = typename Operations::Vector;
+    const size_t width = Operations::width;
+    size_t c = 0;
+    for (; c + 4 * width <= length; c += 4 * width) {
+        Vector minimum0 = Operations::load(minimums + c);
+        Vector minimum1 = Operations::load(minimums + c + width);
+        Vector minimum2 = Operations::load(minimums + c + 2 * width);
+        Vector minimum3 = Operations::load(minimums + c + 3 * width);
+        for (size_t r = 0; r < rowCount; ++r) {
+            const Distance *row = rows[r] + c;
+            minimum0 = Operations::min(Operations::load(row), minimum0);
+            minimum1 = Operations::min(Operations::load(row + width), minimum1);
+            minimum2 = Operations::min(Operations::load(row + 2 * width), minimum2);
+            minimum3 = Operations::min(Operations::load(row + 3 * width), minimum3);
+        }
+        Operations::store(minimums + c, minimum0);
+        Operations::store(minimums + c + width, minimum1);
+        Operations::store(minimums + c + 2 * width, minimum2);
+        Operations::store(minimums + c + 3 * width, minimum3);
+    }
+    for (; c + width <= length; c += width) {
+        Vector minimum = Operations::load(minimums + c);
+        for (size_t r = 0; r < rowCount; ++r) {
+            minimum = Operations::min(Operations::load(rows[r] + c), minimum);
+        }
+        Operations::store(minimums + c, minimum);
+    }
+    for (; c < length; ++c) {
+        for (size_t r = 0; r < rowCount; ++r) {
+            if (rows[r][c] < minimums[c]) {
+                minimums[c] = rows[r][c];
+            }
+        }
+    }
+}
+
+#else
+
+template<class Distance>
+void FacilityLocation::Kernel::minimumAVX2(const Distance *const *rows, size_t rowCount, size_t length,
+                                           Distance *minimums) {
+    minimumScalar(rows, rowCount, length, minimums);
+}
+
+template<class Distance>
+void FacilityLocation::Kernel::minimumAVX512(const Distance *const *rows, size_t rowCount, size_t length,
+                                             Distance *minimums) {
+    minimumScalar(rows, rowCount, length, minimums);
+}
+
+#endif
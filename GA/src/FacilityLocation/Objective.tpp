@@ -1,8 +1,15 @@
-#include <cmath> // INFINITY
+#include <algorithm> // fill, min, sort
+#include <cassert>
+#include <cmath> // pow, INFINITY
+#include <cstdint>
+#include <limits>
+#include <vector>
 
 template<size_t N>
 FacilityLocation::Objective<GA::BinaryRepresentation<N>>::Objective(const FacilityLocation::Instance<N> &instance) :
-        instance(instance) {
+        instance(instance),
+        instructionSet(Kernel::getBestInstructionSet()),
+        walkStepCost(0.) {
 }
 
 template<size_t N>
@@ -10,24 +17,411 @@ const FacilityLocation::Instance<N> &FacilityLocation::Objective<GA::BinaryRepre
     return instance;
 }
 
+template<size_t N>
+FacilityLocation::InstructionSet FacilityLocation::Objective<GA::BinaryRepresentation<N>>::getInstructionSet() const {
+    return instructionSet;
+}
+
+template<size_t N>
+void FacilityLocation::Objective<GA::BinaryRepresentation<N>>::setInstructionSet(
+        FacilityLocation::InstructionSet instructionSet) {
+    assert(Kernel::isSupported(instructionSet));
+    this->instructionSet = instructionSet;
+}
+
+template<size_t N>
+double FacilityLocation::Objective<GA::BinaryRepresentation<N>>::getWalkStepCost() const {
+    if (walkStepCost > 0.) {
+        return walkStepCost;
+    }
+    const double distanceSize = instance.getPrecision() == Precision::Double ? 8.
+                              : instance.getPrecision() == Precision::Float ? 4. : 2.;
+    switch (instructionSet) {
+        case InstructionSet::AVX2:
+            return 40. / distanceSize;
+        case InstructionSet::AVX512:
+            return 50. / distanceSize;
+        case InstructionSet::Scalar:
+            break;
+    }
+    return 2.;
+}
+
+template<size_t N>
+void FacilityLocation::Objective<GA::BinaryRepresentation<N>>::setWalkStepCost(double walkStepCost) {
+    assert(walkStepCost >= 0.);
+    this->walkStepCost = walkStepCost;
+}
+
 template<size_t N>
 double FacilityLocation::Objective<GA::BinaryRepresentation<N>>::operator()(
         const FacilityLocation::Objective<GA::BinaryRepresentation<N>>::Individual &individual) {
+    // Same sums as evaluate, without the allocations of a batch
+    const size_t numberFacility = N != 0 ? N : instance.getNumberFacility();
+    const size_t numberCustomer = instance.getNumberCustomer();
+    assert(individual.size() == numberFacility);
     double result = 0.;
-    for (size_t nF = 0; nF < instance.getNumberFacility(); ++nF) {
+    size_t openCount = 0;
+    for (size_t nF = 0; nF < numberFacility; ++nF) {
         if (individual[nF]) {
             result += instance.cost(nF);
+            ++openCount;
         }
     }
-    double min;
-    for (size_t nC = 0; nC < instance.getNumberCustomer(); ++nC) {
-        min = INFINITY;
-        for (size_t nF = 0; nF < instance.getNumberFacility(); ++nF) {
-            if (individual[nF] && instance.distance(nF, nC) < min) {
-                min = instance.distance(nF, nC);
+    if (openCount == 0) {
+        return numberCustomer != 0 ? std::numeric_limits<double>::infinity() : result;
+    }
+
+    if (instance.getCandidateCount() != 0 && this->isWalkFaster(openCount)) {
+        const size_t candidateCount = instance.getCandidateCount();
+        for (size_t nC = 0; nC < numberCustomer; ++nC) {
+            const uint32_t *candidates = instance.getCandidates(nC);
+            size_t k = 0;
+            while (k < candidateCount && !individual[candidates[k]]) {
+                ++k;
+            }
+            if (k < candidateCount) {
+                result += instance.getCandidateDistances(nC)[k];
+                continue;
             }
+            double minimum = INFINITY;
+            for (size_t nF = 0; nF < numberFacility; ++nF) {
+                if (individual[nF]) {
+                    minimum = std::min(minimum, instance.distance(nF, nC));
+                }
+            }
+            result += minimum;
         }
-        result += min;
+        return result;
+    }
+
+    switch (instance.getPrecision()) {
+        case Precision::Double:
+            return this->addDistances<double>(individual, result);
+        case Precision::Float:
+            return this->addDistances<float>(individual, result);
+        case Precision::Fixed16:
+            return this->addDistances<uint16_t>(individual, result);
     }
     return result;
 }
+
+template<size_t N>
+void FacilityLocation::Objective<GA::BinaryRepresentation<N>>::evaluate(
+        const FacilityLocation::Objective<GA::BinaryRepresentation<N>>::Individual *individuals,
+        double *scores, size_t count) {
+    // A constant when the size is fixed
+    const size_t numberFacility = N != 0 ? N : instance.getNumberFacility();
+
+    // Open facilities of each individual, and their opening costs
+    std::vector<size_t> facilities;
+    std::vector<size_t> firstFacility(count + 1);
+    facilities.reserve(count * numberFacility);
+    for (size_t i = 0; i < count; ++i) {
+        assert(individuals[i].size() == numberFacility);
+        firstFacility[i] = facilities.size();
+        scores[i] = 0.;
+        for (size_t nF = 0; nF < numberFacility; ++nF) {
+            if (individuals[i][nF]) {
+                scores[i] += instance.cost(nF);
+                facilities.push_back(nF);
+            }
+        }
+    }
+    firstFacility[count] = facilities.size();
+
+    // Individuals faster to score by walking the lists of nearest facilities
+    std::vector<size_t> walked;
+    if (instance.getCandidateCount() != 0) {
+        for (size_t i = 0; i < count; ++i) {
+            const size_t openCount = firstFacility[i + 1] - firstFacility[i];
+            if (openCount != 0 && this->isWalkFaster(openCount)) {
+                walked.push_back(i);
+            }
+        }
+        this->addCandidateDistances(individuals, walked, facilities, firstFacility, scores);
+    }
+    if (walked.size() == count) {
+        return;
+    }
+    if (walked.empty()) {
+        this->addDistances(facilities, firstFacility, scores, count);
+        return;
+    }
+
+    // The other individuals are reduced as a batch of their own
+    std::vector<size_t> reduced;
+    std::vector<size_t> reducedFacilities;
+    std::vector<size_t> reducedFirstFacility;
+    std::vector<double> reducedScores;
+    for (size_t i = 0, w = 0; i < count; ++i) {
+        if (w < walked.size() && walked[w] == i) {
+            ++w;
+            continue;
+        }
+        reduced.push_back(i);
+        reducedFirstFacility.push_back(reducedFacilities.size());
+        reducedFacilities.insert(reducedFacilities.end(),
+                                 facilities.begin() + (std::ptrdiff_t) firstFacility[i],
+                                 facilities.begin() + (std::ptrdiff_t) firstFacility[i + 1]);
+        reducedScores.push_back(scores[i]);
+    }
+    reducedFirstFacility.push_back(reducedFacilities.size());
+    this->addDistances(reducedFacilities, reducedFirstFacility, reducedScores.data(), reduced.size());
+    for (size_t r = 0; r < reduced.size(); ++r) {
+        scores[reduced[r]] = reducedScores[r];
+    }
+}
+
+template<size_t N>
+void FacilityLocation::Objective<GA::BinaryRepresentation<N>>::evaluateChildren(
+        const FacilityLocation::Objective<GA::BinaryRepresentation<N>>::Individual *children,
+        const FacilityLocation::Objective<GA::BinaryRepresentation<N>>::Individual *const *parents,
+        double *scores, size_t count) {
+    if (instance.getLayout() != Layout::FacilityMajor || instance.getPrecision() != Precision::Double) {
+        // IncrementalEvaluator needs whole rows of doubles
+        this->evaluate(children, scores, count);
+        return;
+    }
+    std::vector<size_t> order(count);
+    for (size_t i = 0; i < count; ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [parents](size_t a, size_t b) {
+        return parents[a] < parents[b];
+    });
+
+    // Costs are counted in passes over the distances of a facility, as measured by the
+    // benchmarks: the evaluator costs three per open facility to build, a child two
+    // per facility it opens plus two, and a child of a batch one per open facility.
+    std::vector<bool> incremental(count);
+    size_t incrementalCount = 0;
+    for (size_t begin = 0, end; begin < count; begin = end) {
+        const Individual &parent = *parents[order[begin]];
+        const size_t parentCount = parent.count();
+        size_t saving = 0;
+        for (end = begin; end < count && parents[order[end]] == &parent; ++end) {
+            const Individual &child = children[order[end]];
+            size_t opened = 0, closed = 0;
+            for (size_t w = 0; w < parent.getWordCount(); ++w) {
+                opened += (size_t) __builtin_popcountll(child.getWord(w) & ~parent.getWord(w));
+                closed += (size_t) __builtin_popcountll(parent.getWord(w) & ~child.getWord(w));
+            }
+            const size_t batchCost = parentCount + opened - closed;
+            const size_t incrementalCost = 2 * opened + 2;
+            if (incrementalCost < batchCost) {
+                incremental[order[end]] = true;
+                saving += batchCost - incrementalCost;
+            }
+        }
+        if (saving <= 3 * parentCount) {
+            for (size_t i = begin; i < end; ++i) {
+                incremental[order[i]] = false;
+            }
+            continue;
+        }
+        IncrementalEvaluator<N> evaluator(instance);
+        evaluator.reset(parent);
+        for (size_t i = begin; i < end; ++i) {
+            if (incremental[order[i]]) {
+                scores[order[i]] = evaluator.evaluate(children[order[i]], instructionSet);
+                ++incrementalCount;
+            }
+        }
+    }
+
+    if (incrementalCount == 0) {
+        this->evaluate(children, scores, count);
+        return;
+    }
+    std::vector<Individual> batch;
+    batch.reserve(count - incrementalCount);
+    for (size_t i = 0; i < count; ++i) {
+        if (!incremental[i]) {
+            batch.push_back(children[i]);
+        }
+    }
+    std::vector<double> batchScores(batch.size());
+    this->evaluate(batch.data(), batchScores.data(), batch.size());
+    for (size_t i = 0, b = 0; i < count; ++i) {
+        if (!incremental[i]) {
+            scores[i] = batchScores[b++];
+        }
+    }
+}
+
+template<size_t N>
+template<class Distance>
+void FacilityLocation::Objective<GA::BinaryRepresentation<N>>::addDistances(const std::vector<size_t> &facilities,
+                                                                          const std::vector<size_t> &firstFacility,
+                                                                          double *scores, size_t count) const {
+    const size_t numberCustomer = instance.getNumberCustomer();
+    const size_t numberFacility = N != 0 ? N : instance.getNumberFacility();
+    // Stored distances times scale are the distances, scale being exactly 1 unless fixed-point
+    const double scale = instance.getPrecision() == Precision::Fixed16 ? instance.getDistanceStep() : 1.;
+    // Larger than any distance, unless no facility is open
+    const Distance farthest = std::numeric_limits<Distance>::has_infinity ? std::numeric_limits<Distance>::infinity()
+                                                                          : std::numeric_limits<Distance>::max();
+    for (size_t i = 0; i < count; ++i) {
+        if (firstFacility[i] == firstFacility[i + 1] && numberCustomer != 0) {
+            scores[i] = INFINITY;
+        }
+    }
+
+    if (instance.getLayout() == Layout::CustomerMajor) {
+        // Distances of a customer are contiguous, customers are scored one by one
+        for (size_t i = 0; i < count; ++i) {
+            if (firstFacility[i] == firstFacility[i + 1]) {
+                continue;
+            }
+            for (size_t nC = 0; nC < numberCustomer; ++nC) {
+                const Distance *column = instance.template getDistanceColumn<Distance>(nC);
+                Distance minimum = farthest;
+                for (size_t f = firstFacility[i]; f < firstFacility[i + 1]; ++f) {
+                    if (column[facilities[f]] < minimum) {
+                        minimum = column[facilities[f]];
+                    }
+                }
+                scores[i] += (double) minimum * scale;
+            }
+        }
+        return;
+    }
+
+    // A tile is a block of the blocked layout, whose rows are contiguous
+    const size_t tile = instance.getLayout() == Layout::Blocked ? instance.getBlockSize()
+                                                                 : Instance<N>::getDefaultBlockSize(numberFacility);
+    std::vector<Distance> minimums(tile);
+    std::vector<const Distance *> rows(numberFacility);
+    for (size_t begin = 0; begin < numberCustomer; begin += tile) {
+        const size_t end = std::min(begin + tile, numberCustomer);
+        const size_t length = end - begin;
+        for (size_t i = 0; i < count; ++i) {
+            const size_t rowCount = firstFacility[i + 1] - firstFacility[i];
+            if (rowCount == 0) {
+                continue;
+            }
+            for (size_t r = 0; r < rowCount; ++r) {
+                rows[r] = instance.template getDistanceRow<Distance>(facilities[firstFacility[i] + r], begin);
+            }
+            std::fill(minimums.begin(), minimums.begin() + (std::ptrdiff_t) length, farthest);
+            Kernel::minimum(instructionSet, rows.data(), rowCount, length, minimums.data());
+            // Sum in the order of customers, as a customer by customer evaluation would do
+            for (size_t nC = 0; nC < length; ++nC) {
+                scores[i] += (double) minimums[nC] * scale;
+            }
+        }
+    }
+}
+
+template<size_t N>
+void FacilityLocation::Objective<GA::BinaryRepresentation<N>>::addDistances(const std::vector<size_t> &facilities,
+                                                                          const std::vector<size_t> &firstFacility,
+                                                                          double *scores, size_t count) const {
+    switch (instance.getPrecision()) {
+        case Precision::Double:
+            this->addDistances<double>(facilities, firstFacility, scores, count);
+            break;
+        case Precision::Float:
+            this->addDistances<float>(facilities, firstFacility, scores, count);
+            break;
+        case Precision::Fixed16:
+            this->addDistances<uint16_t>(facilities, firstFacility, scores, count);
+            break;
+    }
+}
+
+template<size_t N>
+template<class Distance>
+double FacilityLocation::Objective<GA::BinaryRepresentation<N>>::addDistances(
+        const FacilityLocation::Objective<GA::BinaryRepresentation<N>>::Individual &individual, double score) const {
+    const size_t numberCustomer = instance.getNumberCustomer();
+    const double scale = instance.getPrecision() == Precision::Fixed16 ? instance.getDistanceStep() : 1.;
+    const Distance farthest = std::numeric_limits<Distance>::has_infinity ? std::numeric_limits<Distance>::infinity()
+                                                                          : std::numeric_limits<Distance>::max();
+
+    if (instance.getLayout() == Layout::CustomerMajor) {
+        for (size_t nC = 0; nC < numberCustomer; ++nC) {
+            const Distance *column = instance.template getDistanceColumn<Distance>(nC);
+            Distance minimum = farthest;
+            for (size_t w = 0; w < individual.getWordCount(); ++w) {
+                for (uint64_t word = individual.getWord(w); word != 0; word &= word - 1) {
+                    const size_t nF = 64 * w + (size_t) __builtin_ctzll(word);
+                    if (column[nF] < minimum) {
+                        minimum = column[nF];
+                    }
+                }
+            }
+            score += (double) minimum * scale;
+        }
+        return score;
+    }
+
+    // Tiles fit on the stack and do not cross blocks, whose rows are contiguous, and
+    // the open rows are reduced a word of the individual at a time
+    constexpr size_t tile = 256;
+    Distance minimums[tile];
+    const Distance *rows[64];
+    const size_t block = instance.getBlockSize();
+    for (size_t begin = 0, length; begin < numberCustomer; begin += length) {
+        length = std::min(std::min(tile, numberCustomer - begin), block - begin % block);
+        std::fill(minimums, minimums + length, farthest);
+        for (size_t w = 0; w < individual.getWordCount(); ++w) {
+            size_t rowCount = 0;
+            for (uint64_t word = individual.getWord(w); word != 0; word &= word - 1) {
+                rows[rowCount++] = instance.template getDistanceRow<Distance>(64 * w + (size_t) __builtin_ctzll(word),
+                                                                              begin);
+            }
+            if (rowCount != 0) {
+                Kernel::minimum(instructionSet, rows, rowCount, length, minimums);
+            }
+        }
+        for (size_t nC = 0; nC < length; ++nC) {
+            score += (double) minimums[nC] * scale;
+        }
+    }
+    return score;
+}
+
+template<size_t N>
+bool FacilityLocation::Objective<GA::BinaryRepresentation<N>>::isWalkFaster(size_t openCount) const {
+    // Costs are counted per customer in passes over a distance, as the ones of
+    // evaluateChildren: a reduction costs one per open facility, a walk the steps
+    // given by setWalkStepCost. Open facilities are supposed random.
+    const size_t numberFacility = N != 0 ? N : instance.getNumberFacility();
+    const double open = (double) openCount / (double) numberFacility;
+    const double missed = std::pow(1. - open, (double) instance.getCandidateCount());
+    const double walkSteps = 8. + (1. - missed) / open + 15. * missed * (double) openCount;
+    return this->getWalkStepCost() * walkSteps < (double) openCount;
+}
+
+template<size_t N>
+void FacilityLocation::Objective<GA::BinaryRepresentation<N>>::addCandidateDistances(
+        const FacilityLocation::Objective<GA::BinaryRepresentation<N>>::Individual *individuals,
+        const std::vector<size_t> &walked, const std::vector<size_t> &facilities,
+        const std::vector<size_t> &firstFacility, double *scores) const {
+    const size_t numberCustomer = instance.getNumberCustomer();
+    const size_t candidateCount = instance.getCandidateCount();
+
+    // Customers in the outer loop, for their lists to be read once per batch
+    for (size_t nC = 0; nC < numberCustomer; ++nC) {
+        const uint32_t *candidates = instance.getCandidates(nC);
+        const double *distances = instance.getCandidateDistances(nC);
+        for (size_t i: walked) {
+            size_t k = 0;
+            while (k < candidateCount && !individuals[i][candidates[k]]) {
+                ++k;
+            }
+            if (k < candidateCount) {
+                scores[i] += distances[k];
+                continue;
+            }
+            // None of the nearest facilities is open
+            double minimum = INFINITY;
+            for (size_t f = firstFacility[i]; f < firstFacility[i + 1]; ++f) {
+                minimum = std::min(minimum, instance.distance(facilities[f], nC));
+            }
+            scores[i] += minimum;
+        }
+    }
+}
@@ -1,125 +1,325 @@
-#include <cmath> // INFINITY
-#include <iostream> // cerr, endl
+#include <algorithm> // copy, fill, max, min, partial_sort
+#include <cassert>
+#include <cmath> // isinf, INFINITY
+#include <cstdint>
+#include <set>
+#include <tuple>
 #include <vector>
 #include <FacilityLocation/Instance.h>
 
 template<size_t NF>
-double FacilityLocation::Solver<NF>::bruteForce(FacilityLocation::Instance<NF> &instance,
-                                                FacilityLocation::Objective<GA::BinaryRepresentation<NF>> &objective) {
-    if (instance.getNumberFacility() > sizeof(int) * 8) {
-        std::cerr << "[ERROR] Bruteforce asked for a too big instance (" << instance.getNumberFacility() << ")"
-                  << ". The maximal size authorized is " << sizeof(int) * 8 << std::endl;
+typename FacilityLocation::Solver<NF>::Solution
+FacilityLocation::Solver<NF>::bruteForce(const FacilityLocation::Instance<NF> &instance, GA::ThreadPool *threadPool) {
+    const size_t numberFacility = instance.getNumberFacility();
+    const size_t numberCustomer = instance.getNumberCustomer();
+    assert(numberFacility < 64);
+
+    // Distances in double, whatever the layout and the precision of the instance
+    std::vector<double> distances(numberFacility * numberCustomer);
+    std::vector<double> costs(numberFacility);
+    for (size_t iF = 0; iF < numberFacility; ++iF) {
+        for (size_t iC = 0; iC < numberCustomer; ++iC) {
+            distances[iF * numberCustomer + iC] = instance.distance(iF, iC);
+        }
+        costs[iF] = instance.cost(iF);
     }
-    double bestScore = INFINITY;
-    for (unsigned int n = 1; n <= (int) pow(2, instance.numberFacility); ++n) {
-        GA::BinaryRepresentation<NF> individual(n);
-        double score = objective(individual);
+
+    // A task per set of the last facilities
+    const size_t fixedCount = std::min<size_t>(6, numberFacility);
+    const size_t freeCount = numberFacility - fixedCount;
+    const size_t taskCount = size_t(1) << fixedCount;
+    std::vector<double> scores(taskCount);
+    std::vector<uint64_t> sets(taskCount);
+    auto search = [&](size_t firstTask, size_t lastTask) {
+        for (size_t task = firstTask; task < lastTask; ++task) {
+            scores[task] = searchSets(distances, costs, numberCustomer, freeCount, task, sets[task]);
+        }
+    };
+    if (threadPool != nullptr) {
+        threadPool->parallelFor(0, taskCount, search, 1);
+    } else {
+        search(0, taskCount);
+    }
+
+    size_t best = 0;
+    for (size_t task = 1; task < taskCount; ++task) {
+        if (scores[task] < scores[best]) {
+            best = task;
+        }
+    }
+    Solution solution;
+    solution.individual.resize(numberFacility);
+    for (size_t iF = 0; iF < numberFacility; ++iF) {
+        solution.individual.set(iF, (sets[best] >> iF) & 1);
+    }
+    Objective<GA::BinaryRepresentation<NF>> objective(instance);
+    solution.score = objective(solution.individual);
+    return solution;
+}
+
+template<size_t NF>
+double FacilityLocation::Solver<NF>::searchSets(const std::vector<double> &distances, const std::vector<double> &costs,
+                                                size_t numberCustomer, size_t freeCount, uint64_t fixed,
+                                                uint64_t &bestSet) {
+    // Level j holds, for each customer, the distance to its nearest open facility among
+    // facilities j and above, and the sum of these distances and of the opening costs.
+    // A level whose facility is closed is the level above it, and is not stored.
+    std::vector<double> nearest((freeCount + 1) * numberCustomer, INFINITY);
+    std::vector<const double *> level(freeCount + 1);
+    std::vector<double> distanceSum(freeCount + 1);
+    std::vector<double> costSum(freeCount + 1, 0.);
+
+    // The fixed facilities make the top level
+    double *top = nearest.data() + freeCount * numberCustomer;
+    for (size_t i = 0; (fixed >> i) != 0; ++i) {
+        if ((fixed >> i) & 1) {
+            const double *row = distances.data() + (freeCount + i) * numberCustomer;
+            for (size_t iC = 0; iC < numberCustomer; ++iC) {
+                top[iC] = row[iC] < top[iC] ? row[iC] : top[iC];
+            }
+            costSum[freeCount] += costs[freeCount + i];
+        }
+    }
+    double sum = 0.;
+    for (size_t iC = 0; iC < numberCustomer; ++iC) {
+        sum += top[iC];
+    }
+    level[freeCount] = top;
+    distanceSum[freeCount] = sum;
+
+    uint64_t set = 0; // Open free facilities
+    for (size_t j = freeCount; j-- > 0;) {
+        level[j] = level[j + 1];
+        distanceSum[j] = distanceSum[j + 1];
+        costSum[j] = costSum[j + 1];
+    }
+    double bestScore = costSum[0] + distanceSum[0];
+    bestSet = fixed << freeCount;
+
+    const uint64_t setCount = uint64_t(1) << freeCount;
+    for (uint64_t k = 1; k < setCount; ++k) {
+        // Gray code: the facility changing is the lowest set bit of k
+        const size_t changed = (size_t) __builtin_ctzll(k);
+        set ^= uint64_t(1) << changed;
+        for (size_t j = changed + 1; j-- > 0;) {
+            if (!((set >> j) & 1)) {
+                level[j] = level[j + 1];
+                distanceSum[j] = distanceSum[j + 1];
+                costSum[j] = costSum[j + 1];
+                continue;
+            }
+            const double *above = level[j + 1];
+            const double *row = distances.data() + j * numberCustomer;
+            double *current = nearest.data() + j * numberCustomer;
+            // Eight partial sums, independent for the compiler to vectorize them
+            double sums[8] = {0., 0., 0., 0., 0., 0., 0., 0.};
+            size_t iC = 0;
+            for (; iC + 8 <= numberCustomer; iC += 8) {
+                for (size_t l = 0; l < 8; ++l) {
+                    current[iC + l] = row[iC + l] < above[iC + l] ? row[iC + l] : above[iC + l];
+                    sums[l] += current[iC + l];
+                }
+            }
+            for (; iC < numberCustomer; ++iC) {
+                current[iC] = row[iC] < above[iC] ? row[iC] : above[iC];
+                sums[0] += current[iC];
+            }
+            level[j] = current;
+            distanceSum[j] = ((sums[0] + sums[1]) + (sums[2] + sums[3]))
+                             + ((sums[4] + sums[5]) + (sums[6] + sums[7]));
+            costSum[j] = costSum[j + 1] + costs[j];
+        }
+
+        const double score = costSum[0] + distanceSum[0];
         if (score < bestScore) {
             bestScore = score;
+            bestSet = set | (fixed << freeCount);
         }
     }
     return bestScore;
 }
 
 template<size_t NF>
-double FacilityLocation::Solver<NF>::greedy(FacilityLocation::Instance<NF> &instance) {
-    // This algorithm is based on the paper "A new greedy approach for facility location problems"
-    // by K. Jain, M. Mahdian and A. Saberi
-
-    // The value of budget increments is arbitrary, we choose here a bit less than
-    // the smallest difference between two opening cost (enough to distinguish two facilities)
-    double budgetQuantum = instance.cost(0);
-    for (size_t iF1 = 1; iF1 < instance.numberFacility; ++iF1) {
-        for (size_t iF2 = 0; iF2 < iF1; ++iF2) {
-            if (std::abs(instance.cost(iF2) - instance.cost(iF1)) < budgetQuantum) {
-                budgetQuantum = std::abs(instance.cost(iF2) - instance.cost(iF1));
-            }
+typename FacilityLocation::Solver<NF>::Solution
+FacilityLocation::Solver<NF>::greedy(const FacilityLocation::Instance<NF> &instance, GA::ThreadPool *threadPool) {
+    const size_t numberFacility = instance.getNumberFacility();
+    const size_t numberCustomer = instance.getNumberCustomer();
+    assert(numberFacility <= UINT32_MAX);
+    const size_t none = numberFacility; // Facility of an unconnected customer
+    const Edge first = {-1., 0}; // Lower than any edge
+
+    // Edges of each customer by increasing distance, sorted a chunk at a time as most
+    // customers connect to one of their nearest facilities
+    const size_t chunkSize = std::min<size_t>(16, numberFacility);
+    std::vector<Edge> edges(numberCustomer * chunkSize);
+    auto sortChunks = [&instance, &edges, &first, chunkSize](size_t firstCustomer, size_t lastCustomer) {
+        for (size_t iC = firstCustomer; iC < lastCustomer; ++iC) {
+            sortEdges(instance, iC, first, edges.data() + iC * chunkSize, chunkSize);
         }
+    };
+    if (threadPool != nullptr) {
+        threadPool->parallelFor(0, numberCustomer, sortChunks);
+    } else {
+        sortChunks(0, numberCustomer);
     }
-    budgetQuantum /= 2;
 
-    // INITIALIZATION
+    // State of the customers
+    std::vector<size_t> nextEdge(numberCustomer, 1); // Index in its chunk of the next edge of a customer
+    std::vector<Edge> lastEdge(numberCustomer, first); // Edges up to it are tight, budget >= distance
+    std::vector<size_t> connection(numberCustomer, none);
+    std::vector<double> connectionDistance(numberCustomer, INFINITY);
+    size_t connectedCount = 0;
 
-    bool *connectedCustomer = new bool[instance.numberCustomer];
-    size_t *connection = new size_t[instance.numberCustomer]; // Id of the facility to which the customer is connected
-    double *budgetCustomer = new double[instance.numberCustomer];
-    for (size_t iC = 0; iC < instance.numberCustomer; ++iC) {
-        connectedCustomer[iC] = false;
-        budgetCustomer[iC] = 0.;
-    }
+    // State of the facilities, whose offers at time t are savings + tightCount * t - tightDistance
+    std::vector<bool> opened(numberFacility, false);
+    std::vector<double> savings(numberFacility, 0.); // Offers of the connected customers
+    std::vector<size_t> tightCount(numberFacility, 0); // Number of unconnected customers with a tight edge
+    std::vector<double> tightDistance(numberFacility, 0.); // Sum of the distances of these edges
+    double time = 0.;
+    auto getOpeningTime = [&](size_t facility) {
+        const double offers = savings[facility] + (double) tightCount[facility] * time - tightDistance[facility];
+        if (offers >= instance.cost(facility)) {
+            return time;
+        }
+        if (tightCount[facility] == 0) {
+            return (double) INFINITY;
+        }
+        return (instance.cost(facility) - savings[facility] + tightDistance[facility]) / (double) tightCount[facility];
+    };
 
-    bool *openedFacility = new bool[instance.numberFacility];
-    for (size_t iF = 0; iF < instance.numberFacility; ++iF) {
-        openedFacility[iF] = false;
+    // Events, earliest first. Offers only increase with a new tight edge, when the
+    // opening time of the facility is queued again. Queued opening times are thus
+    // lower bounds, checked when they come first.
+    using CustomerEvent = std::tuple<double, uint32_t, size_t>; // Distance, facility, customer
+    using FacilityEvent = std::pair<double, size_t>; // Opening time, facility
+    std::set<CustomerEvent> customerEvents;
+    std::set<FacilityEvent> facilityEvents;
+    for (size_t iC = 0; iC < numberCustomer; ++iC) {
+        customerEvents.emplace(edges[iC * chunkSize].distance, edges[iC * chunkSize].facility, iC);
+    }
+    for (size_t iF = 0; iF < numberFacility; ++iF) {
+        if (!(instance.cost(iF) > 0.)) {
+            facilityEvents.emplace(0., iF);
+        }
     }
 
-    // ITERATION
-    do {
-        // Increase budgets of unconnected customers
-        for (size_t iC = 0; iC < instance.numberCustomer; ++iC) {
-            if (!connectedCustomer[iC]) {
-                budgetCustomer[iC] += budgetQuantum;
+    auto connect = [&](size_t customer, size_t facility) {
+        connection[customer] = facility;
+        connectionDistance[customer] = instance.distance(facility, customer);
+        ++connectedCount;
+        // The offer of the customer goes from its budget to its saving
+        for (size_t iF = 0; iF < numberFacility; ++iF) {
+            if (opened[iF]) {
+                continue;
+            }
+            const Edge edge = {instance.distance(iF, customer), (uint32_t) iF};
+            if (!(lastEdge[customer] < edge)) {
+                --tightCount[iF];
+                tightDistance[iF] -= edge.distance;
+            }
+            if (edge.distance < connectionDistance[customer]) {
+                savings[iF] += connectionDistance[customer] - edge.distance;
+            }
+        }
+    };
+    auto reconnect = [&](size_t customer, size_t facility) {
+        const double oldDistance = connectionDistance[customer];
+        const double newDistance = instance.distance(facility, customer);
+        connection[customer] = facility;
+        connectionDistance[customer] = newDistance;
+        for (size_t iF = 0; iF < numberFacility; ++iF) {
+            const double distance = instance.distance(iF, customer);
+            if (!opened[iF] && distance < oldDistance) {
+                savings[iF] -= oldDistance - std::max(distance, newDistance);
             }
         }
+    };
 
-        // Updates connections
-        for (size_t iF = 0; iF < instance.numberFacility; ++iF) {
-            if (openedFacility[iF]) {
-                for (size_t iC = 0; iC < instance.numberCustomer; ++iC) {
-                    if (!connectedCustomer[iC] && budgetCustomer[iC] >= instance.distance(iF, iC)) {
-                        // Connection of a customer to an already opened facility
-                        connection[iC] = iF;
-                        connectedCustomer[iC] = true;
-                    }
-                }
-            } else {
-                double budgetFacility = 0.;
-                for (size_t iC = 0; iC < instance.numberCustomer; ++iC) {
-                    if (connectedCustomer[iC] && instance.distance(connection[iC], iC) > instance.distance(iF, iC)) {
-                        budgetFacility += instance.distance(connection[iC], iC) - instance.distance(iF, iC);
-                    } else if (!connectedCustomer[iC] && budgetCustomer[iC] > instance.distance(iF, iC)) {
-                        budgetFacility += budgetCustomer[iC] - instance.distance(iF, iC);
-                    }
+    while (connectedCount < numberCustomer) {
+        if (!facilityEvents.empty() && (customerEvents.empty()
+                                        || !(std::get<0>(*customerEvents.begin()) < facilityEvents.begin()->first))) {
+            const size_t facility = facilityEvents.begin()->second;
+            const double queuedTime = facilityEvents.begin()->first;
+            facilityEvents.erase(facilityEvents.begin());
+            if (opened[facility]) {
+                continue;
+            }
+            time = std::max(time, queuedTime);
+            const double openingTime = getOpeningTime(facility);
+            if (openingTime > time) {
+                if (!std::isinf(openingTime)) {
+                    facilityEvents.emplace(openingTime, facility);
                 }
-                if (budgetFacility >= instance.cost(iF)) {
-                    // Open a new facility and connect customers which had contributed
-                    for (size_t iC = 0; iC < instance.numberCustomer; ++iC) {
-                        if (connectedCustomer[iC] &&
-                            instance.distance(connection[iC], iC) > instance.distance(iF, iC)) {
-                            connection[iC] = iF;
-                            connectedCustomer[iC] = true;
-                        } else if (!connectedCustomer[iC] && budgetCustomer[iC] > instance.distance(iF, iC)) {
-                            connection[iC] = iF;
-                            connectedCustomer[iC] = true;
-                        }
+                continue;
+            }
+
+            // The facility opens, takes the customers with a tight edge to it, and the
+            // connected customers nearer to it
+            opened[facility] = true;
+            for (size_t iC = 0; iC < numberCustomer; ++iC) {
+                const Edge edge = {instance.distance(facility, iC), (uint32_t) facility};
+                if (connection[iC] == none) {
+                    if (!(lastEdge[iC] < edge)) {
+                        connect(iC, facility);
                     }
-                    openedFacility[iF] = true;
+                } else if (edge.distance < connectionDistance[iC]) {
+                    reconnect(iC, facility);
                 }
             }
+            continue;
         }
 
-    } while (containsFalse(connectedCustomer, instance.numberCustomer));
-
-    // COMPUTE SCORE
-    double score = 0.;
-    for (size_t iF = 0; iF < instance.numberFacility; ++iF) {
-        if (openedFacility[iF]) {
-            score += instance.cost(iF);
+        // The budget of a customer reaches its distance to a facility
+        assert(!customerEvents.empty());
+        const Edge edge = {std::get<0>(*customerEvents.begin()), std::get<1>(*customerEvents.begin())};
+        const size_t customer = std::get<2>(*customerEvents.begin());
+        customerEvents.erase(customerEvents.begin());
+        if (connection[customer] != none) {
+            continue;
+        }
+        time = std::max(time, edge.distance);
+        lastEdge[customer] = edge;
+        Edge *chunk = edges.data() + customer * chunkSize;
+        if (nextEdge[customer] == chunkSize) {
+            sortEdges(instance, customer, edge, chunk, chunkSize);
+            nextEdge[customer] = 0;
+        }
+        if (!std::isinf(chunk[nextEdge[customer]].distance)) {
+            customerEvents.emplace(chunk[nextEdge[customer]].distance, chunk[nextEdge[customer]].facility, customer);
+            ++nextEdge[customer];
+        }
+        if (opened[edge.facility]) {
+            connect(customer, edge.facility);
+        } else {
+            ++tightCount[edge.facility];
+            tightDistance[edge.facility] += edge.distance;
+            facilityEvents.emplace(std::max(time, getOpeningTime(edge.facility)), edge.facility);
         }
-    }
-    for (size_t iC = 0; iC < instance.numberCustomer; ++iC) {
-        score += instance.distance(connection[iC], iC);
     }
 
-    return score;
+    Solution solution;
+    solution.individual.resize(numberFacility);
+    for (size_t iF = 0; iF < numberFacility; ++iF) {
+        solution.individual.set(iF, opened[iF]);
+    }
+    Objective<GA::BinaryRepresentation<NF>> objective(instance);
+    solution.score = objective(solution.individual);
+    return solution;
 }
 
 template<size_t NF>
-bool FacilityLocation::Solver<NF>::containsFalse(const bool *array, size_t size) {// Search for unconnected customers
-    for (size_t i = 0; i < size; ++i) {
-        if (!array[i]) {
-            return true;
+void FacilityLocation::Solver<NF>::sortEdges(const FacilityLocation::Instance<NF> &instance, size_t customer,
+                                             const Edge &last, Edge *edges, size_t edgeCount) {
+    std::vector<Edge> next;
+    next.reserve(instance.getNumberFacility());
+    for (size_t iF = 0; iF < instance.getNumberFacility(); ++iF) {
+        const Edge edge = {instance.distance(iF, customer), (uint32_t) iF};
+        if (last < edge) {
+            next.push_back(edge);
         }
     }
-    return false;
+    const size_t count = std::min(edgeCount, next.size());
+    std::partial_sort(next.begin(), next.begin() + (std::ptrdiff_t) count, next.end());
+    std::copy(next.begin(), next.begin() + (std::ptrdiff_t) count, edges);
+    std::fill(edges + count, edges + edgeCount, Edge{INFINITY, 0});
 }
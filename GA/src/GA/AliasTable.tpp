@@ -0,0 +1,70 @@
+#include <cassert>
+#include <random>
+#include <GA/AliasTable.h>
+
+inline void GA::AliasTable::build(const std::vector<double> &weights) {
+    assert(!weights.empty());
+    const size_t n = weights.size();
+    probability.resize(n);
+    alias.resize(n);
+
+    double total = 0.;
+    for (double weight: weights) {
+        assert(weight >= 0.);
+        total += weight;
+    }
+    if (!(total > 0.)) {
+        for (size_t i = 0; i < n; ++i) {
+            probability[i] = 1.;
+            alias[i] = i;
+        }
+        return;
+    }
+
+    // Scale the weights so that their mean is 1, then pair underfull and overfull columns
+    small.clear();
+    large.clear();
+    for (size_t i = 0; i < n; ++i) {
+        probability[i] = weights[i] * (double) n / total;
+        alias[i] = i;
+        if (probability[i] < 1.) {
+            small.push_back(i);
+        } else {
+            large.push_back(i);
+        }
+    }
+    while (!small.empty() && !large.empty()) {
+        size_t less = small.back();
+        size_t more = large.back();
+        small.pop_back();
+        alias[less] = more;
+        probability[more] -= 1. - probability[less];
+        if (probability[more] < 1.) {
+            large.pop_back();
+            small.push_back(more);
+        }
+    }
+    // Remaining columns are full, up to rounding errors
+    for (size_t i: small) {
+        probability[i] = 1.;
+    }
+    for (size_t i: large) {
+        probability[i] = 1.;
+    }
+}
+
+inline size_t GA::AliasTable::size() const {
+    return probability.size();
+}
+
+template<class RandomEngine>
+size_t GA::AliasTable::operator()(RandomEngine &rnd) const {
+    assert(!probability.empty());
+    std::uniform_real_distribution<double> distrib(0., (double) probability.size());
+    double x = distrib(rnd);
+    size_t column = (size_t) x;
+    if (column >= probability.size()) {
+        column = probability.size() - 1;
+    }
+    return x - (double) column < probability[column] ? column : alias[column];
+}
@@ -1,25 +1,26 @@
+#include <cassert>
 #include <queue>
 #include <algorithm>
 
 template<size_t N>
 GA::MultiPointCrossover<GA::BinaryRepresentation<N>>::MultiPointCrossover(const unsigned int numberPoint) :
     numberPoint(numberPoint) {
-    std::random_device rndDevice;
-    this->rnd.seed(rndDevice());
 }
 
 template<size_t N>
 GA::BinaryRepresentation<N>
 GA::MultiPointCrossover<GA::BinaryRepresentation<N>>::operator()(const GA::BinaryRepresentation<N> &individual1,
-                                                               const GA::BinaryRepresentation<N> &individual2) {
-    std::uniform_int_distribution<size_t> distrib(0, N-1);
-    BinaryRepresentation<N> child;
+                                                               const GA::BinaryRepresentation<N> &individual2,
+                                                               GA::RandomEngine &rnd) {
+    assert(individual1.size() == individual2.size());
+    std::uniform_int_distribution<size_t> distrib(0, individual1.size() - 1);
+    BinaryRepresentation<N> child(individual1);
     std::vector<size_t> points(numberPoint);
     for (unsigned int i = 0; i < numberPoint; ++i) {
         points[i] = distrib(rnd);
     }
     std::sort(points.begin(), points.end());
-    points.push_back(N);
+    points.push_back(individual1.size());
 
     size_t n = 0;
     bool chooseIndividual1 = true;
@@ -1,23 +1,21 @@
-template<size_t N>
-GA::SinglePointCrossover<GA::BinaryRepresentation<N>>::SinglePointCrossover() {
-    std::random_device rndDevice;
-    this->rnd.seed(rndDevice());
-}
+#include <cassert>
 
 template<size_t N>
 GA::BinaryRepresentation<N>
 GA::SinglePointCrossover<GA::BinaryRepresentation<N>>::operator()(const GA::BinaryRepresentation<N> &individual1,
-                                                               const GA::BinaryRepresentation<N> &individual2) {
-    std::uniform_int_distribution<size_t> distrib(0, N-1);
-    BinaryRepresentation<N> child;
-    size_t n;
+                                                               const GA::BinaryRepresentation<N> &individual2,
+                                                               GA::RandomEngine &rnd) {
+    assert(individual1.size() == individual2.size());
+    std::uniform_int_distribution<size_t> distrib(0, individual1.size() - 1);
+    BinaryRepresentation<N> child(individual1);
     size_t point = distrib(rnd);
 
-    for (n = 0; n < point; ++n) {
-        child.set(n, individual1[n]);
-    }
-    for (; n < N; ++n) {
-        child.set(n, individual2[n]);
+    // Bits lower than point come from individual1, the others from individual2
+    size_t w = point / 64;
+    uint64_t mask = (uint64_t(1) << (point % 64)) - 1;
+    child.setWord(w, (individual1.getWord(w) & mask) | (individual2.getWord(w) & ~mask));
+    for (++w; w < child.getWordCount(); ++w) {
+        child.setWord(w, individual2.getWord(w));
     }
     return child;
 }
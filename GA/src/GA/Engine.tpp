@@ -1,171 +1,574 @@
+#include <algorithm> // min
 #include <cassert>
 #include <cmath> // sqrt
+#include <cstdio> // rename, remove
+#include <fstream>
+#include <sstream>
 #include <GA/Engine.h>
 
-template<class Individual>
-GA::Engine<Individual>::Engine(Objective<Individual> &objective,
-                               Crossover<Individual> &crossover,
-                               Mutation<Individual> &mutation,
-                               Selection<Individual> &selection) :
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::Engine(ObjectiveT &objective,
+                                                                              CrossoverT &crossover,
+                                                                              MutationT &mutation,
+                                                                              SelectionT &selection) :
         objective(objective),
         crossover(crossover),
         mutation(mutation),
         selection(selection),
+        parentSampling(&defaultParentSampling),
+        defaultParentSampling(),
         populationSize(1),
-        population() {
+        replacement(Replacement::Generational),
+        offspringCount(1),
+        prototype(),
+        population(),
+        nextPopulation(),
+        generation(0),
+        evaluationCount(0),
+        profile(),
+        ownedThreadPool(),
+        threadPool(nullptr),
+        offspring(),
+        offspringScores(),
+        offspringPending(0),
+        offspringParents(),
+        breedingSeeds(),
+        bred(),
+        bredParents(),
+        breedingProfiles() {
     std::random_device rndDevice;
     this->rnd.seed(rndDevice());
 }
 
-template<class Individual>
-GA::Objective<Individual> &GA::Engine<Individual>::getObjective() const {
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+ObjectiveT &GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::getObjective() const {
     return this->objective;
 }
 
-template<class Individual>
-GA::Crossover<Individual> &GA::Engine<Individual>::getCrossover() const {
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+CrossoverT &GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::getCrossover() const {
     return this->crossover;
 }
 
-template<class Individual>
-GA::Mutation<Individual> &GA::Engine<Individual>::getMutation() const {
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+MutationT &GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::getMutation() const {
     return this->mutation;
 }
 
-template<class Individual>
-GA::Selection<Individual> &GA::Engine<Individual>::getSelection() const {
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+SelectionT &GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::getSelection() const {
     return this->selection;
 }
 
-template<class Individual>
-size_t GA::Engine<Individual>::getPopulationSize() const {
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+GA::ParentSampling<Individual> &
+GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::getParentSampling() const {
+    return *this->parentSampling;
+}
+
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+size_t GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::getPopulationSize() const {
     return this->populationSize;
 }
 
-template<class Individual>
-void GA::Engine<Individual>::setObjective(GA::Objective<Individual> &objective) {
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+typename GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::Replacement
+GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::getReplacement() const {
+    return replacement;
+}
+
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+size_t GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::getOffspringCount() const {
+    return offspringCount;
+}
+
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+size_t GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::getThreadCount() const {
+    return threadPool == nullptr ? 1 : threadPool->getThreadCount();
+}
+
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+const Individual &GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::getPrototype() const {
+    return prototype;
+}
+
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+void GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::setSeed(uint64_t seed) {
+    rnd.seed(seed);
+}
+
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+void GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::setObjective(ObjectiveT &objective) {
     this->objective = objective;
 }
 
-template<class Individual>
-void GA::Engine<Individual>::setCrossover(GA::Crossover<Individual> &crossover) {
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+void GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::setCrossover(CrossoverT &crossover) {
     this->crossover = crossover;
 }
 
-template<class Individual>
-void GA::Engine<Individual>::setMutation(GA::Mutation<Individual> &mutation) {
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+void GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::setMutation(MutationT &mutation) {
     this->mutation = mutation;
 }
 
-template<class Individual>
-void GA::Engine<Individual>::setSelection(GA::Selection<Individual> &selection) {
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+void GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::setSelection(SelectionT &selection) {
     this->selection = selection;
 }
 
-template<class Individual>
-void GA::Engine<Individual>::setPopulationSize(size_t populationSize) {
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+void GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::setParentSampling(
+        GA::ParentSampling<Individual> &parentSampling) {
+    this->parentSampling = &parentSampling;
+}
+
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+void GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::setPopulationSize(size_t populationSize) {
     assert(populationSize != 0);
     this->populationSize = populationSize;
 }
 
-template<class Individual>
-void GA::Engine<Individual>::initialize() {
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+void GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::setReplacement(Replacement replacement) {
+    this->replacement = replacement;
+}
+
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+void GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::setOffspringCount(size_t offspringCount) {
+    assert(offspringCount != 0);
+    this->offspringCount = offspringCount;
+}
+
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+void GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::setThreadCount(size_t threadCount) {
+    if (threadCount <= 1) {
+        ownedThreadPool.reset();
+        threadPool = nullptr;
+    } else {
+        ownedThreadPool.reset(new ThreadPool(threadCount));
+        threadPool = ownedThreadPool.get();
+    }
+}
+
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+void GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::setThreadPool(GA::ThreadPool &threadPool) {
+    ownedThreadPool.reset();
+    this->threadPool = &threadPool;
+}
+
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+void GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::setPrototype(const Individual &prototype) {
+    this->prototype = prototype;
+}
+
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+void GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::initialize() {
+    offspring.assign(populationSize, prototype);
+    for (Individual &individual: offspring) {
+        individual.randomize(rnd);
+    }
+    offspringPending = offspring.size();
+    offspringParents.clear();
+    evaluationCount = 0;
+    this->evaluateOffspring();
+
     population.clear();
-    Individual individual;
-    for (size_t i = populationSize; i != 0; --i) {
-        individual.randomize();
-        population.emplace(objective(individual), individual);
+    population.reserve(populationSize);
+    for (size_t i = 0; i < populationSize; ++i) {
+        population.add(offspringScores[i], std::move(offspring[i]));
     }
+    population.sort();
+    generation = 0;
 }
 
-template<class Individual>
-void GA::Engine<Individual>::initialize(size_t populationSize) {
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+void GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::initialize(size_t populationSize) {
     assert(populationSize != 0);
     this->setPopulationSize(populationSize);
     return this->initialize();
 }
 
-template<class Individual>
-double GA::Engine<Individual>::step() {
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+double GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::step() {
     return this->step(1);
 }
 
-template<class Individual>
-double GA::Engine<Individual>::step(unsigned int numberStep) {
-    typename Population::iterator it1, it2;
-    std::uniform_int_distribution<size_t> unif_distrib(0,population.size()*(population.size()+1)/2);
-    Individual individual;
-    Population new_population;
-
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+double GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::step(unsigned int numberStep) {
     for (unsigned int i = numberStep; i != 0; --i) {
+        this->advance();
+    }
+    return population.getScore(0);
+}
 
-        new_population = selection(population);
-
-        while (new_population.size() < populationSize) {
-            it1 = population.begin();
-            it2 = population.begin();
-            /*
-             * We choose random parents after the following probability distribution :
-             * P(i) = (n-i) / (n(n+1)/2)
-             */
-            std::advance(it1, population.size() - std::floor(std::sqrt(1+8*unif_distrib(rnd))-1.5));
-            std::advance(it2, population.size() - std::floor(std::sqrt(1+8*unif_distrib(rnd))-1.5));
-
-            individual = mutation(crossover(it1->second, it2->second));
-
-            new_population.emplace(objective(individual), individual);
-        }
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+unsigned int GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::run(GA::Termination &termination) {
+    return this->run(termination, [](const Engine &) {});
+}
 
-        std::swap(new_population, population);
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+template<class Callback>
+unsigned int GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::run(GA::Termination &termination,
+                                                                                        Callback callback) {
+    termination.start(generation, evaluationCount, population.getScore(0));
+    unsigned int reached;
+    while ((reached = termination.check(generation, evaluationCount, population.getScore(0))) == 0) {
+        this->advance();
+        callback(*this);
     }
-    return population.cbegin()->first;
+    return reached;
 }
 
-template<class Individual>
-double GA::Engine<Individual>::getScore() const {
-    return population.cbegin()->first;
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+double GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::getScore() const {
+    return population.getScore(0);
 }
 
-template<class Individual>
-const Individual GA::Engine<Individual>::getBest() const {
-    return population.cbegin()->second;
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+const Individual GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::getBest() const {
+    return population.getIndividual(0);
 }
 
-template<class Individual>
-double GA::Engine<Individual>::getMean() const {
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+double GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::getMean() const {
     return this->getMean(population.size());
 }
 
-template<class Individual>
-double GA::Engine<Individual>::getMean(size_t count) const {
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+double GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::getMean(size_t count) const {
     assert(count <= population.size());
+    const std::vector<double> &scores = population.getScores();
     double total = 0.;
-    auto it = population.cbegin();
-    for (int i = 0; i < count; ++i) {
-        total += it->first;
-        it++;
+    for (size_t i = 0; i < count; ++i) {
+        total += scores[i];
     }
-    return total / count;
+    return total / (double) count;
 }
 
-template<class Individual>
-double GA::Engine<Individual>::getStandardDeviation() const {
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+double GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::getStandardDeviation() const {
     return getStandardDeviation(population.size());
 }
 
-template<class Individual>
-double GA::Engine<Individual>::getStandardDeviation(size_t count) const {
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+double GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::getStandardDeviation(size_t count) const {
     assert(count <= population.size());
+    const std::vector<double> &scores = population.getScores();
     double mean = 0.;
     double meanOfSquares = 0.;
-    auto it = population.cbegin();
     for (size_t i = 0; i < count; ++i) {
-        meanOfSquares += it->first * it->first;
-        mean += it->first;
-        it++;
+        meanOfSquares += scores[i] * scores[i];
+        mean += scores[i];
     }
-    meanOfSquares /= count;
-    mean /= count;
+    meanOfSquares /= (double) count;
+    mean /= (double) count;
     return std::sqrt(meanOfSquares - mean*mean);
 }
 
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+unsigned long GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::getGeneration() const {
+    return generation;
+}
+
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+unsigned long GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::getEvaluationCount() const {
+    return evaluationCount;
+}
+
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+const GA::Profile &GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::getProfile() const {
+    return profile;
+}
+
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+void GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::resetProfile() {
+    profile.reset();
+}
+
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+const typename GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::Population &
+GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::getPopulation() const {
+    return population;
+}
+
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+typename GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::Population
+GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::emigrate(size_t count) const {
+    assert(count <= population.size());
+    Population emigrants;
+    emigrants.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        emigrants.add(population.getScore(i), population.getIndividual(i));
+    }
+    return emigrants;
+}
+
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+void GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::immigrate(const Population &immigrants) {
+    size_t size = population.size();
+    population.reserve(size + immigrants.size());
+    for (size_t i = 0; i < immigrants.size(); ++i) {
+        population.add(immigrants.getScore(i), immigrants.getIndividual(i));
+    }
+    population.sort();
+    population.truncate(size);
+}
+
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+bool GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::saveCheckpoint(const std::string &path) const {
+    const size_t wordCount = prototype.getWordCount();
+    const size_t count = population.size();
+
+    std::vector<uint64_t> words(count * wordCount);
+    for (size_t i = 0; i < count; ++i) {
+        population.getIndividual(i).getWords(words.data() + i * wordCount);
+    }
+    std::ostringstream rndStream;
+    rndStream << rnd;
+    const std::string rndState = rndStream.str();
+
+    const uint64_t header[] = {checkpointMagic, checkpointVersion, wordCount,
+                               populationSize, generation, evaluationCount, count, rndState.size()};
+
+    const std::string temporaryPath = path + ".tmp";
+    std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(rndState.data(), (std::streamsize) rndState.size());
+    file.write(reinterpret_cast<const char*>(words.data()), (std::streamsize) (words.size() * sizeof(uint64_t)));
+    file.write(reinterpret_cast<const char*>(population.getScores().data()), (std::streamsize) (count * sizeof(double)));
+    file.close();
+
+    if (!file || std::rename(temporaryPath.c_str(), path.c_str()) != 0) {
+        std::remove(temporaryPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+bool GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::loadCheckpoint(const std::string &path) {
+    const size_t wordCount = prototype.getWordCount();
+
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    const uint64_t fileSize = (uint64_t) file.tellg();
+    file.seekg(0);
+
+    uint64_t header[8];
+    if (fileSize < sizeof(header) || !file.read(reinterpret_cast<char*>(header), sizeof(header))) {
+        return false;
+    }
+    const uint64_t savedPopulationSize = header[3];
+    const uint64_t savedGeneration = header[4];
+    const uint64_t savedEvaluationCount = header[5];
+    const uint64_t count = header[6];
+    const uint64_t rndStateSize = header[7];
+    if (header[0] != checkpointMagic || header[1] != checkpointVersion || header[2] != wordCount
+        || savedPopulationSize == 0 || count == 0 || count > savedPopulationSize) {
+        return false;
+    }
+    // Sizes are checked against the file before any allocation
+    const uint64_t individualSize = wordCount * sizeof(uint64_t) + sizeof(double);
+    const uint64_t remaining = fileSize - sizeof(header);
+    if (rndStateSize > remaining || count != (remaining - rndStateSize) / individualSize
+        || count * individualSize != remaining - rndStateSize) {
+        return false;
+    }
+
+    std::string rndState(rndStateSize, '\0');
+    std::vector<uint64_t> words(count * wordCount);
+    std::vector<double> scores(count);
+    file.read(&rndState[0], (std::streamsize) rndStateSize);
+    file.read(reinterpret_cast<char*>(words.data()), (std::streamsize) (words.size() * sizeof(uint64_t)));
+    file.read(reinterpret_cast<char*>(scores.data()), (std::streamsize) (count * sizeof(double)));
+    if (!file) {
+        return false;
+    }
+
+    RandomEngine loadedRnd;
+    std::istringstream rndStream(rndState);
+    rndStream >> loadedRnd;
+    if (!rndStream) {
+        return false;
+    }
+
+    Population loaded;
+    loaded.reserve(count);
+    Individual individual(prototype);
+    for (size_t i = 0; i < count; ++i) {
+        individual.setWords(words.data() + i * wordCount);
+        loaded.add(scores[i], individual);
+    }
+    loaded.sort();
+
+    population.swap(loaded);
+    populationSize = savedPopulationSize;
+    generation = savedGeneration;
+    evaluationCount = savedEvaluationCount;
+    rnd = loadedRnd;
+    return true;
+}
+
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+void GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::advance() {
+    GA_PROFILE_GENERATION(profile);
+    if (replacement == Replacement::SteadyState) {
+        this->stepSteadyState();
+    } else {
+        this->stepGenerational();
+    }
+    ++generation;
+}
+
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+void GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::stepGenerational() {
+    {
+        GA_PROFILE_SCOPE(profile, Profile::Selection);
+        nextPopulation = selection(population, rnd);
+        nextPopulation.reserve(populationSize);
+    }
+
+    size_t count = nextPopulation.size() < populationSize ? populationSize - nextPopulation.size() : 0;
+    this->breedOffspring(count);
+    {
+        GA_PROFILE_SCOPE(profile, Profile::Objective);
+        GA_PROFILE_EVALUATIONS(profile, offspringPending);
+        this->evaluateOffspring();
+    }
+
+    GA_PROFILE_SCOPE(profile, Profile::Insertion);
+    for (size_t n = 0; n < count; ++n) {
+        nextPopulation.add(offspringScores[n], std::move(offspring[n]));
+    }
+    nextPopulation.sort();
+    population.swap(nextPopulation);
+}
+
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+void GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::stepSteadyState() {
+    this->breedOffspring(offspringCount);
+    {
+        GA_PROFILE_SCOPE(profile, Profile::Objective);
+        GA_PROFILE_EVALUATIONS(profile, offspringPending);
+        this->evaluateOffspring();
+    }
+
+    GA_PROFILE_SCOPE(profile, Profile::Insertion);
+    for (size_t n = 0; n < offspringCount; ++n) {
+        if (population.size() < populationSize) {
+            population.insert(offspringScores[n], std::move(offspring[n]));
+        } else if (offspringScores[n] <= population.getScore(population.size() - 1)) {
+            population.replaceWorst(offspringScores[n], std::move(offspring[n]));
+        }
+    }
+    population.truncate(populationSize);
+}
+
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+void GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::breedOffspring(size_t count) {
+    offspring.resize(count);
+    offspringScores.resize(count);
+    offspringParents.resize(count);
+    {
+        GA_PROFILE_SCOPE(profile, Profile::ParentSampling);
+        parentSampling->prepare(population);
+    }
+
+    // Chunks of fixed size, each with its own random engine seeded in the order of the
+    // chunks, so that children do not depend on the number of threads breeding them
+    const size_t chunkCount = (count + breedingChunk - 1) / breedingChunk;
+    breedingSeeds.resize(chunkCount);
+    for (uint64_t &seed: breedingSeeds) {
+        seed = rnd();
+    }
+    bred.resize(count);
+    bredParents.resize(count);
+    if (Profile::enabled) {
+        breedingProfiles.assign(chunkCount, Profile());
+    }
+    auto breed = [this, count](size_t firstChunk, size_t lastChunk) {
+        for (size_t chunk = firstChunk; chunk < lastChunk; ++chunk) {
+            RandomEngine chunkRnd(breedingSeeds[chunk]);
+            for (size_t n = chunk * breedingChunk; n < std::min(count, (chunk + 1) * breedingChunk); ++n) {
+                size_t index1, index2;
+                {
+                    GA_PROFILE_SCOPE(breedingProfiles[chunk], Profile::ParentSampling);
+                    index1 = (*parentSampling)(chunkRnd);
+                    index2 = (*parentSampling)(chunkRnd);
+                }
+                {
+                    GA_PROFILE_SCOPE(breedingProfiles[chunk], Profile::Crossover);
+                    bred[n] = crossover(population.getIndividual(index1), population.getIndividual(index2), chunkRnd);
+                }
+                {
+                    GA_PROFILE_SCOPE(breedingProfiles[chunk], Profile::Mutation);
+                    mutation(bred[n], chunkRnd);
+                }
+                bredParents[n] = {index1, index2};
+            }
+        }
+    };
+    if (threadPool == nullptr || chunkCount == 1) {
+        breed(0, chunkCount);
+    } else {
+        threadPool->parallelFor(0, chunkCount, breed, 1);
+    }
+    if (Profile::enabled) {
+        for (const Profile &chunkProfile: breedingProfiles) {
+            profile.add(chunkProfile);
+        }
+    }
+
+    // Individuals to evaluate are gathered at the front, the others at the back
+    size_t front = 0;
+    size_t back = count;
+    for (size_t n = 0; n < count; ++n) {
+        const size_t index1 = bredParents[n].first;
+        const size_t index2 = bredParents[n].second;
+        const Individual &parent1 = population.getIndividual(index1);
+        // At low mutation rates, many children are a plain copy of a parent
+        if (bred[n] == parent1) {
+            --back;
+            offspringScores[back] = population.getScore(index1);
+            offspring[back] = std::move(bred[n]);
+        } else if (bred[n] == population.getIndividual(index2)) {
+            --back;
+            offspringScores[back] = population.getScore(index2);
+            offspring[back] = std::move(bred[n]);
+        } else {
+            offspring[front] = std::move(bred[n]);
+            offspringParents[front] = &parent1;
+            ++front;
+        }
+    }
+    offspringPending = front;
+}
+
+template<class Individual, class ObjectiveT, class CrossoverT, class MutationT, class SelectionT>
+void GA::Engine<Individual, ObjectiveT, CrossoverT, MutationT, SelectionT>::evaluateOffspring() {
+    offspringScores.resize(offspring.size());
+    if (offspringPending == 0) {
+        return;
+    }
+    evaluationCount += offspringPending;
+    // Individuals of the initial population have no parent
+    auto evaluate = [this](size_t first, size_t last) {
+        if (offspringParents.empty()) {
+            objective.evaluate(offspring.data() + first, offspringScores.data() + first, last - first);
+        } else {
+            objective.evaluateChildren(offspring.data() + first, offspringParents.data() + first,
+                                       offspringScores.data() + first, last - first);
+        }
+    };
+    if (threadPool == nullptr) {
+        evaluate(0, offspringPending);
+        return;
+    }
+    // One batch per thread, so that each batch is as large as possible
+    size_t threadCount = threadPool->getThreadCount();
+    size_t grain = (offspringPending + threadCount - 1) / threadCount;
+    threadPool->parallelFor(0, offspringPending, evaluate, grain);
+}
@@ -0,0 +1,201 @@
+#include <algorithm> // min
+#include <cassert>
+#include <GA/IslandEngine.h>
+
+template<class Individual>
+GA::IslandEngine<Individual>::IslandEngine() :
+        islands(),
+        threadPool(),
+        topology(Topology::Ring),
+        migrationInterval(10),
+        migrationSize(1),
+        generation(0) {
+    std::random_device rndDevice;
+    this->rnd.seed(rndDevice());
+}
+
+template<class Individual>
+GA::Engine<Individual> &GA::IslandEngine<Individual>::addIsland(GA::Objective<Individual> &objective,
+                                                                GA::Crossover<Individual> &crossover,
+                                                                GA::Mutation<Individual> &mutation,
+                                                                GA::Selection<Individual> &selection) {
+    islands.emplace_back(new Engine<Individual>(objective, crossover, mutation, selection));
+    threadPool.reset();
+    return *islands.back();
+}
+
+template<class Individual>
+size_t GA::IslandEngine<Individual>::getNumberIsland() const {
+    return islands.size();
+}
+
+template<class Individual>
+GA::Engine<Individual> &GA::IslandEngine<Individual>::getIsland(size_t index) {
+    assert(index < islands.size());
+    return *islands[index];
+}
+
+template<class Individual>
+const GA::Engine<Individual> &GA::IslandEngine<Individual>::getIsland(size_t index) const {
+    assert(index < islands.size());
+    return *islands[index];
+}
+
+template<class Individual>
+typename GA::IslandEngine<Individual>::Topology GA::IslandEngine<Individual>::getTopology() const {
+    return topology;
+}
+
+template<class Individual>
+unsigned int GA::IslandEngine<Individual>::getMigrationInterval() const {
+    return migrationInterval;
+}
+
+template<class Individual>
+size_t GA::IslandEngine<Individual>::getMigrationSize() const {
+    return migrationSize;
+}
+
+template<class Individual>
+void GA::IslandEngine<Individual>::setTopology(Topology topology) {
+    this->topology = topology;
+}
+
+template<class Individual>
+void GA::IslandEngine<Individual>::setMigrationInterval(unsigned int migrationInterval) {
+    assert(migrationInterval != 0);
+    this->migrationInterval = migrationInterval;
+}
+
+template<class Individual>
+void GA::IslandEngine<Individual>::setMigrationSize(size_t migrationSize) {
+    this->migrationSize = migrationSize;
+}
+
+template<class Individual>
+void GA::IslandEngine<Individual>::setSeed(uint64_t seed) {
+    rnd.seed(seed);
+}
+
+template<class Individual>
+void GA::IslandEngine<Individual>::initialize(size_t populationSize) {
+    assert(!islands.empty());
+    assert(migrationSize <= populationSize);
+    for (auto &island: islands) {
+        island->setSeed(rnd());
+    }
+    if (!threadPool) {
+        threadPool.reset(new ThreadPool(islands.size()));
+    }
+    threadPool->parallelFor(0, islands.size(), [this, populationSize](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            islands[i]->initialize(populationSize);
+        }
+    }, 1);
+    generation = 0;
+}
+
+template<class Individual>
+double GA::IslandEngine<Individual>::step() {
+    return this->step(1);
+}
+
+template<class Individual>
+double GA::IslandEngine<Individual>::step(unsigned int numberStep) {
+    assert(threadPool);
+    while (numberStep != 0) {
+        // Run every island up to the next migration, or to the end of the call
+        unsigned int count = migrationInterval - (unsigned int) (generation % migrationInterval);
+        count = std::min(count, numberStep);
+        threadPool->parallelFor(0, islands.size(), [this, count](size_t first, size_t last) {
+            for (size_t i = first; i < last; ++i) {
+                islands[i]->step(count);
+            }
+        }, 1);
+        generation += count;
+        numberStep -= count;
+
+        if (generation % migrationInterval == 0) {
+            this->migrate();
+        }
+    }
+    return this->getScore();
+}
+
+template<class Individual>
+double GA::IslandEngine<Individual>::getScore() const {
+    return islands[this->getBestIsland()]->getScore();
+}
+
+template<class Individual>
+const Individual GA::IslandEngine<Individual>::getBest() const {
+    return islands[this->getBestIsland()]->getBest();
+}
+
+template<class Individual>
+unsigned long GA::IslandEngine<Individual>::getGeneration() const {
+    return generation;
+}
+
+template<class Individual>
+void GA::IslandEngine<Individual>::migrate() {
+    const size_t numberIsland = islands.size();
+    if (numberIsland < 2 || migrationSize == 0) {
+        return;
+    }
+
+    // Every emigrant is chosen before the first arrival
+    std::vector<Population> emigrants;
+    emigrants.reserve(numberIsland);
+    for (const auto &island: islands) {
+        emigrants.push_back(island->emigrate(std::min(migrationSize, island->getPopulation().size())));
+    }
+
+    std::vector<Population> immigrants(numberIsland);
+    auto send = [&emigrants, &immigrants](size_t from, size_t to) {
+        for (size_t i = 0; i < emigrants[from].size(); ++i) {
+            immigrants[to].add(emigrants[from].getScore(i), emigrants[from].getIndividual(i));
+        }
+    };
+    switch (topology) {
+        case Topology::Ring:
+            for (size_t from = 0; from < numberIsland; ++from) {
+                send(from, (from + 1) % numberIsland);
+            }
+            break;
+        case Topology::FullyConnected:
+            for (size_t from = 0; from < numberIsland; ++from) {
+                for (size_t to = 0; to < numberIsland; ++to) {
+                    if (to != from) {
+                        send(from, to);
+                    }
+                }
+            }
+            break;
+        case Topology::Random: {
+            std::uniform_int_distribution<size_t> distrib(1, numberIsland - 1);
+            for (size_t from = 0; from < numberIsland; ++from) {
+                send(from, (from + distrib(rnd)) % numberIsland);
+            }
+            break;
+        }
+    }
+
+    for (size_t to = 0; to < numberIsland; ++to) {
+        if (!immigrants[to].empty()) {
+            islands[to]->immigrate(immigrants[to]);
+        }
+    }
+}
+
+template<class Individual>
+size_t GA::IslandEngine<Individual>::getBestIsland() const {
+    assert(!islands.empty());
+    size_t best = 0;
+    for (size_t i = 1; i < islands.size(); ++i) {
+        if (islands[i]->getScore() < islands[best]->getScore()) {
+            best = i;
+        }
+    }
+    return best;
+}
@@ -1,10 +1,9 @@
 #include <cassert>
+#include <random>
 
 template<size_t N>
 GA::RandomMutation<GA::BinaryRepresentation<N>>::RandomMutation(double probability) {
     this->setProbability(probability);
-    std::random_device rndDevice;
-    this->rnd.seed(rndDevice());
 }
 
 template<size_t N>
@@ -21,7 +20,7 @@ void GA::RandomMutation<GA::BinaryRepresentation<N>>::setProbability(double prob
 template<size_t N>
 typename GA::RandomMutation<GA::BinaryRepresentation<N>>::Individual
 GA::RandomMutation<GA::BinaryRepresentation<N>>::operator()(
-        GA::RandomMutation<GA::BinaryRepresentation<N>>::Individual &individual) {
+        GA::RandomMutation<GA::BinaryRepresentation<N>>::Individual &individual, GA::RandomEngine &rnd) {
     std::uniform_real_distribution<double> probaRand(0., 1.);
     for (size_t n = 0; n < individual.size(); ++n) {
         if (probaRand(rnd) < probability) {
@@ -34,8 +33,8 @@ GA::RandomMutation<GA::BinaryRepresentation<N>>::operator()(
 template<size_t N>
 typename GA::RandomMutation<GA::BinaryRepresentation<N>>::Individual
 GA::RandomMutation<GA::BinaryRepresentation<N>>::operator()(
-        const GA::RandomMutation<GA::BinaryRepresentation<N>>::Individual &individual) {
+        const GA::RandomMutation<GA::BinaryRepresentation<N>>::Individual &individual, GA::RandomEngine &rnd) {
     GA::RandomMutation<GA::BinaryRepresentation<N>>::Individual newIndividual(individual);
-    this->operator()(newIndividual);
+    this->operator()(newIndividual, rnd);
     return newIndividual;
 }
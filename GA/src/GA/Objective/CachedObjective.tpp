@@ -0,0 +1,162 @@
+#include <cassert>
+#include <GA/Objective/CachedObjective.h>
+
+template<class Individual, class Hash>
+GA::CachedObjective<Individual, Hash>::CachedObjective(GA::Objective<Individual> &objective, size_t capacity) :
+        objective(objective),
+        capacity(capacity),
+        index(),
+        entries(),
+        hand(0),
+        hitCount(0),
+        missCount(0) {
+    assert(capacity != 0);
+    index.reserve(capacity);
+    entries.reserve(capacity);
+}
+
+template<class Individual, class Hash>
+double GA::CachedObjective<Individual, Hash>::operator()(const Individual &individual) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = index.find(individual);
+        if (it != index.end()) {
+            Entry &entry = entries[it->second];
+            entry.referenced = true;
+            ++hitCount;
+            return entry.score;
+        }
+        ++missCount;
+    }
+    // The evaluation is done without holding the lock
+    double score = objective(individual);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        this->store(individual, score);
+    }
+    return score;
+}
+
+template<class Individual, class Hash>
+void GA::CachedObjective<Individual, Hash>::evaluate(const Individual *individuals, double *scores, size_t count) {
+    std::vector<size_t> missPositions = this->lookup(individuals, scores, count);
+    if (missPositions.empty()) {
+        return;
+    }
+    std::vector<Individual> misses;
+    misses.reserve(missPositions.size());
+    for (size_t position: missPositions) {
+        misses.push_back(individuals[position]);
+    }
+    std::vector<double> missScores(misses.size());
+    objective.evaluate(misses.data(), missScores.data(), misses.size());
+    this->storeMisses(individuals, scores, missPositions, missScores);
+}
+
+template<class Individual, class Hash>
+void GA::CachedObjective<Individual, Hash>::evaluateChildren(const Individual *children,
+                                                             const Individual *const *parents, double *scores,
+                                                             size_t count) {
+    std::vector<size_t> missPositions = this->lookup(children, scores, count);
+    if (missPositions.empty()) {
+        return;
+    }
+    std::vector<Individual> misses;
+    std::vector<const Individual *> missParents;
+    misses.reserve(missPositions.size());
+    missParents.reserve(missPositions.size());
+    for (size_t position: missPositions) {
+        misses.push_back(children[position]);
+        missParents.push_back(parents[position]);
+    }
+    std::vector<double> missScores(misses.size());
+    objective.evaluateChildren(misses.data(), missParents.data(), missScores.data(), misses.size());
+    this->storeMisses(children, scores, missPositions, missScores);
+}
+
+template<class Individual, class Hash>
+size_t GA::CachedObjective<Individual, Hash>::getCapacity() const {
+    return capacity;
+}
+
+template<class Individual, class Hash>
+size_t GA::CachedObjective<Individual, Hash>::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+template<class Individual, class Hash>
+size_t GA::CachedObjective<Individual, Hash>::getHitCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hitCount;
+}
+
+template<class Individual, class Hash>
+size_t GA::CachedObjective<Individual, Hash>::getMissCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return missCount;
+}
+
+template<class Individual, class Hash>
+void GA::CachedObjective<Individual, Hash>::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    index.clear();
+    entries.clear();
+    hand = 0;
+    hitCount = 0;
+    missCount = 0;
+}
+
+template<class Individual, class Hash>
+std::vector<size_t>
+GA::CachedObjective<Individual, Hash>::lookup(const Individual *individuals, double *scores, size_t count) {
+    std::vector<size_t> missPositions;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < count; ++i) {
+        auto it = index.find(individuals[i]);
+        if (it != index.end()) {
+            Entry &entry = entries[it->second];
+            entry.referenced = true;
+            scores[i] = entry.score;
+            ++hitCount;
+        } else {
+            missPositions.push_back(i);
+        }
+    }
+    missCount += missPositions.size();
+    return missPositions;
+}
+
+template<class Individual, class Hash>
+void GA::CachedObjective<Individual, Hash>::storeMisses(const Individual *individuals, double *scores,
+                                                        const std::vector<size_t> &missPositions,
+                                                        const std::vector<double> &missScores) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t m = 0; m < missPositions.size(); ++m) {
+        scores[missPositions[m]] = missScores[m];
+        this->store(individuals[missPositions[m]], missScores[m]);
+    }
+}
+
+template<class Individual, class Hash>
+void GA::CachedObjective<Individual, Hash>::store(const Individual &individual, double score) {
+    if (index.find(individual) != index.end()) {
+        // Evaluated concurrently by another thread
+        return;
+    }
+    if (entries.size() < capacity) {
+        index.emplace(individual, entries.size());
+        entries.push_back(Entry{individual, score, false});
+        return;
+    }
+    // Move the hand until an entry without a recent hit is found
+    while (entries[hand].referenced) {
+        entries[hand].referenced = false;
+        hand = (hand + 1) % capacity;
+    }
+    index.erase(entries[hand].individual);
+    entries[hand].individual = individual;
+    entries[hand].score = score;
+    index.emplace(individual, hand);
+    hand = (hand + 1) % capacity;
+}
@@ -13,6 +13,23 @@ GA::DeadBitInsertion<GA::BinaryRepresentation<N>, GA::BinaryRepresentation<M>>::
 template<size_t N, size_t M>
 double GA::DeadBitInsertion<GA::BinaryRepresentation<N>, GA::BinaryRepresentation<M>>::operator()(
         const GA::BinaryRepresentation<M> &individual) {
+    return initialObjective(this->decode(individual));
+}
+
+template<size_t N, size_t M>
+void GA::DeadBitInsertion<GA::BinaryRepresentation<N>, GA::BinaryRepresentation<M>>::evaluate(
+        const GA::BinaryRepresentation<M> *individuals, double *scores, size_t count) {
+    std::vector<GA::BinaryRepresentation<N>> initialIndividuals;
+    initialIndividuals.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        initialIndividuals.push_back(this->decode(individuals[i]));
+    }
+    initialObjective.evaluate(initialIndividuals.data(), scores, count);
+}
+
+template<size_t N, size_t M>
+GA::BinaryRepresentation<N> GA::DeadBitInsertion<GA::BinaryRepresentation<N>, GA::BinaryRepresentation<M>>::decode(
+        const GA::BinaryRepresentation<M> &individual) const {
     GA::BinaryRepresentation<N> initialIndividual;
     size_t i;
     for (i = 0; i < position; i++) {
@@ -21,5 +38,5 @@ double GA::DeadBitInsertion<GA::BinaryRepresentation<N>, GA::BinaryRepresentatio
     for (; i < N; i++) {
         initialIndividual.set(i, individual[i + length]);
     }
-    return initialObjective(initialIndividual);
+    return initialIndividual;
 }
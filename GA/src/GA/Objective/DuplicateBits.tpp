@@ -12,15 +12,32 @@ GA::DuplicateBits<GA::BinaryRepresentation<N>, GA::BinaryRepresentation<M>>::Dup
 template<size_t N, size_t M>
 double GA::DuplicateBits<GA::BinaryRepresentation<N>, GA::BinaryRepresentation<M>>::operator()(
         const GA::BinaryRepresentation<M> &individual) {
+    return initialObjective(this->decode(individual));
+}
+
+template<size_t N, size_t M>
+void GA::DuplicateBits<GA::BinaryRepresentation<N>, GA::BinaryRepresentation<M>>::evaluate(
+        const GA::BinaryRepresentation<M> *individuals, double *scores, size_t count) {
+    std::vector<GA::BinaryRepresentation<N>> initialIndividuals;
+    initialIndividuals.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        initialIndividuals.push_back(this->decode(individuals[i]));
+    }
+    initialObjective.evaluate(initialIndividuals.data(), scores, count);
+}
+
+template<size_t N, size_t M>
+GA::BinaryRepresentation<N> GA::DuplicateBits<GA::BinaryRepresentation<N>, GA::BinaryRepresentation<M>>::decode(
+        const GA::BinaryRepresentation<M> &individual) const {
     GA::BinaryRepresentation<N> initialIndividual;
     size_t i, j;
-    int value;
+    unsigned int votes;
     for (i = 0; i < N; i++) {
-        value = 0;
+        votes = 0;
         for (j = 0; j < redundancy; j++) {
-            value += (individual[(i*redundancy + j*redundancy*offset + j) % M])? 1 : -1;
+            votes += (individual[(i*redundancy + j*redundancy*offset + j) % M])? 1u : 0u;
         }
-        initialIndividual.set(i, value >= 0);
+        initialIndividual.set(i, 2*votes >= redundancy);
     }
-    return initialObjective(initialIndividual);
+    return initialIndividual;
 }
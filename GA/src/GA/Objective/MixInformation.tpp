@@ -14,6 +14,23 @@ GA::MixInformation<GA::BinaryRepresentation<N>, GA::BinaryRepresentation<M>>::Mi
 template<size_t N, size_t M>
 double GA::MixInformation<GA::BinaryRepresentation<N>, GA::BinaryRepresentation<M>>::operator()(
         const GA::BinaryRepresentation<M> &individual) {
+    return initialObjective(this->decode(individual));
+}
+
+template<size_t N, size_t M>
+void GA::MixInformation<GA::BinaryRepresentation<N>, GA::BinaryRepresentation<M>>::evaluate(
+        const GA::BinaryRepresentation<M> *individuals, double *scores, size_t count) {
+    std::vector<GA::BinaryRepresentation<N>> initialIndividuals;
+    initialIndividuals.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        initialIndividuals.push_back(this->decode(individuals[i]));
+    }
+    initialObjective.evaluate(initialIndividuals.data(), scores, count);
+}
+
+template<size_t N, size_t M>
+GA::BinaryRepresentation<N> GA::MixInformation<GA::BinaryRepresentation<N>, GA::BinaryRepresentation<M>>::decode(
+        const GA::BinaryRepresentation<M> &individual) const {
     GA::BinaryRepresentation<N> initialIndividual;
     size_t i, j;
     for (i = 0; i < N; i++) {
@@ -24,5 +41,5 @@ double GA::MixInformation<GA::BinaryRepresentation<N>, GA::BinaryRepresentation<
             }
         }
     }
-    return initialObjective(initialIndividual);
+    return initialIndividual;
 }
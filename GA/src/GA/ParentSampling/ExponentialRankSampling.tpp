@@ -0,0 +1,43 @@
+#include <cassert>
+
+template<class Individual>
+GA::ExponentialRankSampling<Individual>::ExponentialRankSampling(double ratio) :
+        table(),
+        tableValid(false),
+        weights() {
+    this->setRatio(ratio);
+}
+
+template<class Individual>
+double GA::ExponentialRankSampling<Individual>::getRatio() const {
+    return ratio;
+}
+
+template<class Individual>
+void GA::ExponentialRankSampling<Individual>::setRatio(double ratio) {
+    assert(0. < ratio && ratio <= 1.);
+    this->ratio = ratio;
+    tableValid = false;
+}
+
+template<class Individual>
+void GA::ExponentialRankSampling<Individual>::prepare(const Population &population) {
+    assert(population.isSorted());
+    if (tableValid && table.size() == population.size()) {
+        return;
+    }
+    const size_t size = population.size();
+    weights.resize(size);
+    double weight = 1.;
+    for (size_t i = 0; i < size; ++i) {
+        weights[i] = weight;
+        weight *= ratio;
+    }
+    table.build(weights);
+    tableValid = true;
+}
+
+template<class Individual>
+size_t GA::ExponentialRankSampling<Individual>::operator()(RandomEngine &rnd) {
+    return table(rnd);
+}
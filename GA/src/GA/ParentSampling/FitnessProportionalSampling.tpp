@@ -0,0 +1,30 @@
+#include <cmath> // isfinite
+
+template<class Individual>
+GA::FitnessProportionalSampling<Individual>::FitnessProportionalSampling() :
+        table(),
+        weights() {
+}
+
+template<class Individual>
+void GA::FitnessProportionalSampling<Individual>::prepare(const Population &population) {
+    const std::vector<double> &scores = population.getScores();
+    bool found = false;
+    double worst = 0.;
+    for (double score: scores) {
+        if (std::isfinite(score) && (!found || score > worst)) {
+            worst = score;
+            found = true;
+        }
+    }
+    weights.resize(scores.size());
+    for (size_t i = 0; i < scores.size(); ++i) {
+        weights[i] = std::isfinite(scores[i]) ? worst - scores[i] : 0.;
+    }
+    table.build(weights);
+}
+
+template<class Individual>
+size_t GA::FitnessProportionalSampling<Individual>::operator()(RandomEngine &rnd) {
+    return table(rnd);
+}
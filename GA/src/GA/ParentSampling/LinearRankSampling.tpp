@@ -0,0 +1,26 @@
+#include <cassert>
+
+template<class Individual>
+GA::LinearRankSampling<Individual>::LinearRankSampling() :
+        table(),
+        weights() {
+}
+
+template<class Individual>
+void GA::LinearRankSampling<Individual>::prepare(const Population &population) {
+    assert(population.isSorted());
+    if (table.size() == population.size()) {
+        return;
+    }
+    const size_t size = population.size();
+    weights.resize(size);
+    for (size_t i = 0; i < size; ++i) {
+        weights[i] = (double) (size - i);
+    }
+    table.build(weights);
+}
+
+template<class Individual>
+size_t GA::LinearRankSampling<Individual>::operator()(RandomEngine &rnd) {
+    return table(rnd);
+}
@@ -0,0 +1,179 @@
+#include <algorithm> // sort, partial_sort, upper_bound, rotate
+#include <cassert>
+#include <numeric> // iota
+#include <GA/Population.h>
+
+template<class Individual>
+GA::Population<Individual>::Population() :
+        individuals(),
+        scores(),
+        sortedCount(0),
+        order(),
+        individualsBuffer(),
+        scoresBuffer() {
+}
+
+template<class Individual>
+size_t GA::Population<Individual>::size() const {
+    return scores.size();
+}
+
+template<class Individual>
+bool GA::Population<Individual>::empty() const {
+    return scores.empty();
+}
+
+template<class Individual>
+void GA::Population<Individual>::clear() {
+    individuals.clear();
+    scores.clear();
+    sortedCount = 0;
+}
+
+template<class Individual>
+void GA::Population<Individual>::reserve(size_t capacity) {
+    individuals.reserve(capacity);
+    scores.reserve(capacity);
+}
+
+template<class Individual>
+void GA::Population<Individual>::add(double score, const Individual &individual) {
+    Individual copy(individual);
+    this->add(score, std::move(copy));
+}
+
+template<class Individual>
+void GA::Population<Individual>::add(double score, Individual &&individual) {
+    if (sortedCount == scores.size() && (scores.empty() || scores.back() <= score)) {
+        ++sortedCount;
+    } else if (sortedCount != 0 && score < scores[sortedCount - 1]) {
+        // Only the best individuals which are still better than the new one remain ranked
+        sortedCount = (size_t) (std::upper_bound(scores.cbegin(), scores.cbegin() + (std::ptrdiff_t) sortedCount, score)
+                                - scores.cbegin());
+    }
+    individuals.push_back(std::move(individual));
+    scores.push_back(score);
+}
+
+template<class Individual>
+void GA::Population<Individual>::insert(double score, Individual &&individual) {
+    assert(this->isSorted());
+    individuals.push_back(std::move(individual));
+    scores.push_back(score);
+    this->rankLast();
+}
+
+template<class Individual>
+void GA::Population<Individual>::replaceWorst(double score, Individual &&individual) {
+    assert(this->isSorted());
+    assert(!scores.empty());
+    individuals.back() = std::move(individual);
+    scores.back() = score;
+    this->rankLast();
+}
+
+template<class Individual>
+void GA::Population<Individual>::truncate(size_t count) {
+    if (count >= scores.size()) {
+        return;
+    }
+    individuals.erase(individuals.begin() + (std::ptrdiff_t) count, individuals.end());
+    scores.resize(count);
+    if (sortedCount > count) {
+        sortedCount = count;
+    }
+}
+
+template<class Individual>
+const Individual &GA::Population<Individual>::getIndividual(size_t index) const {
+    assert(index < individuals.size());
+    return individuals[index];
+}
+
+template<class Individual>
+double GA::Population<Individual>::getScore(size_t index) const {
+    assert(index < scores.size());
+    return scores[index];
+}
+
+template<class Individual>
+const std::vector<Individual> &GA::Population<Individual>::getIndividuals() const {
+    return individuals;
+}
+
+template<class Individual>
+const std::vector<double> &GA::Population<Individual>::getScores() const {
+    return scores;
+}
+
+template<class Individual>
+bool GA::Population<Individual>::isSorted() const {
+    return sortedCount == scores.size();
+}
+
+template<class Individual>
+bool GA::Population<Individual>::isSorted(size_t count) const {
+    return sortedCount >= count || sortedCount == scores.size();
+}
+
+template<class Individual>
+void GA::Population<Individual>::sort() {
+    if (this->isSorted()) {
+        return;
+    }
+    order.resize(scores.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](size_t i, size_t j) {
+        return scores[i] < scores[j];
+    });
+    this->applyOrder(order.size());
+}
+
+template<class Individual>
+void GA::Population<Individual>::partialSort(size_t count) {
+    if (this->isSorted(count)) {
+        return;
+    }
+    if (count >= scores.size()) {
+        return this->sort();
+    }
+    order.resize(scores.size());
+    std::iota(order.begin(), order.end(), 0);
+    // Ties are broken by index so that the result does not depend on the implementation
+    std::partial_sort(order.begin(), order.begin() + (std::ptrdiff_t) count, order.end(), [this](size_t i, size_t j) {
+        return scores[i] < scores[j] || (!(scores[j] < scores[i]) && i < j);
+    });
+    this->applyOrder(count);
+}
+
+template<class Individual>
+void GA::Population<Individual>::swap(GA::Population<Individual> &population) {
+    using std::swap;
+    swap(individuals, population.individuals);
+    swap(scores, population.scores);
+    swap(sortedCount, population.sortedCount);
+}
+
+template<class Individual>
+void GA::Population<Individual>::applyOrder(size_t count) {
+    individualsBuffer.clear();
+    scoresBuffer.clear();
+    individualsBuffer.reserve(individuals.size());
+    scoresBuffer.reserve(scores.size());
+    for (size_t index: order) {
+        individualsBuffer.push_back(std::move(individuals[index]));
+        scoresBuffer.push_back(scores[index]);
+    }
+    std::swap(individuals, individualsBuffer);
+    std::swap(scores, scoresBuffer);
+    sortedCount = count;
+}
+
+template<class Individual>
+void GA::Population<Individual>::rankLast() {
+    auto position = std::upper_bound(scores.begin(), scores.end() - 1, scores.back());
+    std::ptrdiff_t index = position - scores.begin();
+    std::rotate(position, scores.end() - 1, scores.end());
+    std::rotate(individuals.begin() + index, individuals.end() - 1, individuals.end());
+    sortedCount = scores.size();
+}
@@ -0,0 +1,113 @@
+#include <chrono>
+#include <GA/Profile.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h> // __rdtsc
+#endif
+
+inline void GA::Profile::reset() {
+    *this = Profile();
+}
+
+inline void GA::Profile::add(const Profile &profile) {
+    for (size_t phase = 0; phase < PhaseCount; ++phase) {
+        cycles[phase] += profile.cycles[phase];
+        allocations[phase] += profile.allocations[phase];
+    }
+}
+
+inline uint64_t GA::Profile::getTotalCycles() const {
+    uint64_t total = 0;
+    for (size_t phase = 0; phase < PhaseCount; ++phase) {
+        total += cycles[phase];
+    }
+    return total;
+}
+
+inline uint64_t GA::Profile::getTotalAllocations() const {
+    uint64_t total = 0;
+    for (size_t phase = 0; phase < PhaseCount; ++phase) {
+        total += allocations[phase];
+    }
+    return total;
+}
+
+inline double GA::Profile::getEvaluationsPerSecond() const {
+    return seconds > 0. ? (double) evaluations / seconds : 0.;
+}
+
+inline void GA::Profile::writeJson(std::ostream &out) const {
+    out << "{\"enabled\": " << (enabled ? "true" : "false")
+        << ", \"generations\": " << generations
+        << ", \"seconds\": " << seconds
+        << ", \"evaluations\": " << evaluations
+        << ", \"evaluationsPerSecond\": " << this->getEvaluationsPerSecond()
+        << ", \"cycles\": " << this->getTotalCycles()
+        << ", \"allocations\": " << this->getTotalAllocations()
+        << ", \"phases\": {";
+    for (size_t phase = 0; phase < PhaseCount; ++phase) {
+        out << (phase == 0 ? "" : ", ") << "\"" << getPhaseName((Phase) phase) << "\": {"
+            << "\"cycles\": " << cycles[phase]
+            << ", \"allocations\": " << allocations[phase] << "}";
+    }
+    out << "}}";
+}
+
+inline const char *GA::Profile::getPhaseName(Phase phase) {
+    switch (phase) {
+        case Selection:
+            return "selection";
+        case ParentSampling:
+            return "parentSampling";
+        case Crossover:
+            return "crossover";
+        case Mutation:
+            return "mutation";
+        case Objective:
+            return "objective";
+        case Insertion:
+            return "insertion";
+        case PhaseCount:
+            break;
+    }
+    return "";
+}
+
+inline uint64_t GA::Profile::readCycles() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+inline uint64_t &GA::Profile::allocationCounter() {
+    static thread_local uint64_t counter = 0;
+    return counter;
+}
+
+inline GA::ProfileScope::ProfileScope(Profile &profile, Profile::Phase phase) :
+        profile(profile),
+        phase(phase),
+        startCycles(Profile::readCycles()),
+        startAllocations(Profile::allocationCounter()) {
+}
+
+inline GA::ProfileScope::~ProfileScope() {
+    profile.cycles[phase] += Profile::readCycles() - startCycles;
+    profile.allocations[phase] += Profile::allocationCounter() - startAllocations;
+}
+
+inline GA::ProfileGeneration::ProfileGeneration(Profile &profile) :
+        profile(profile),
+        startNanoseconds((uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count()) {
+}
+
+inline GA::ProfileGeneration::~ProfileGeneration() {
+    uint64_t endNanoseconds = (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    profile.seconds += (double) (endNanoseconds - startNanoseconds) * 1e-9;
+    ++profile.generations;
+}
@@ -1,26 +1,294 @@
 #include <cassert>
-#include <random>
+#include <algorithm> // copy, fill
+#include <cstring> // memcpy, memcmp
 
 template <size_t N>
-GA::BinaryRepresentation<N>::BinaryRepresentation() {
-    std::random_device rndDevice;
-    this->rnd.seed(rndDevice());
+GA::BinaryRepresentation<N>::BinaryRepresentation() : Representation(), words() {
 }
 
 template<size_t N>
-GA::BinaryRepresentation<N>::BinaryRepresentation(unsigned long val) : Representation(), std::bitset<N>(val) {
-    std::random_device rndDevice;
-    this->rnd.seed(rndDevice());
+GA::BinaryRepresentation<N>::BinaryRepresentation(unsigned long long val) : Representation(), words() {
+    words[0] = (uint64_t) val;
+    words[wordCount - 1] &= lastWordMask;
 }
 
 template<size_t N>
-void GA::BinaryRepresentation<N>::randomize() {
-    std::bernoulli_distribution distrib(0.5);
-    size_t i = 0;
-    while (i < N) {
-        if (distrib(rnd)) {
-            this->flip(i);
+void GA::BinaryRepresentation<N>::resize(size_t size) {
+    assert(size == N);
+    (void) size;
+}
+
+template<size_t N>
+void GA::BinaryRepresentation<N>::randomize(GA::RandomEngine &rnd) {
+    static_assert(GA::RandomEngine::max() == ~uint64_t(0) && GA::RandomEngine::min() == 0,
+                  "The random engine must produce 64 random bits per call");
+    for (size_t w = 0; w < wordCount; ++w) {
+        words[w] = rnd();
+    }
+    words[wordCount - 1] &= lastWordMask;
+}
+
+template<size_t N>
+bool GA::BinaryRepresentation<N>::operator[](size_t pos) const {
+    return (words[pos / 64] >> (pos % 64)) & 1;
+}
+
+template<size_t N>
+bool GA::BinaryRepresentation<N>::test(size_t pos) const {
+    assert(pos < N);
+    return (*this)[pos];
+}
+
+template<size_t N>
+GA::BinaryRepresentation<N> &GA::BinaryRepresentation<N>::set() {
+    for (size_t w = 0; w < wordCount; ++w) {
+        words[w] = ~uint64_t(0);
+    }
+    words[wordCount - 1] &= lastWordMask;
+    return *this;
+}
+
+template<size_t N>
+GA::BinaryRepresentation<N> &GA::BinaryRepresentation<N>::set(size_t pos, bool value) {
+    assert(pos < N);
+    const uint64_t bit = uint64_t(1) << (pos % 64);
+    if (value) {
+        words[pos / 64] |= bit;
+    } else {
+        words[pos / 64] &= ~bit;
+    }
+    return *this;
+}
+
+template<size_t N>
+GA::BinaryRepresentation<N> &GA::BinaryRepresentation<N>::reset() {
+    for (size_t w = 0; w < wordCount; ++w) {
+        words[w] = 0;
+    }
+    return *this;
+}
+
+template<size_t N>
+GA::BinaryRepresentation<N> &GA::BinaryRepresentation<N>::reset(size_t pos) {
+    return this->set(pos, false);
+}
+
+template<size_t N>
+GA::BinaryRepresentation<N> &GA::BinaryRepresentation<N>::flip() {
+    for (size_t w = 0; w < wordCount; ++w) {
+        words[w] = ~words[w];
+    }
+    words[wordCount - 1] &= lastWordMask;
+    return *this;
+}
+
+template<size_t N>
+GA::BinaryRepresentation<N> &GA::BinaryRepresentation<N>::flip(size_t pos) {
+    assert(pos < N);
+    words[pos / 64] ^= uint64_t(1) << (pos % 64);
+    return *this;
+}
+
+template<size_t N>
+size_t GA::BinaryRepresentation<N>::count() const {
+    size_t result = 0;
+    for (size_t w = 0; w < wordCount; ++w) {
+        result += (size_t) __builtin_popcountll(words[w]);
+    }
+    return result;
+}
+
+template<size_t N>
+bool GA::BinaryRepresentation<N>::any() const {
+    for (size_t w = 0; w < wordCount; ++w) {
+        if (words[w] != 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<size_t N>
+bool GA::BinaryRepresentation<N>::none() const {
+    return !this->any();
+}
+
+template<size_t N>
+bool GA::BinaryRepresentation<N>::operator==(const GA::BinaryRepresentation<N> &other) const {
+    return std::memcmp(words, other.words, sizeof(words)) == 0;
+}
+
+template<size_t N>
+bool GA::BinaryRepresentation<N>::operator!=(const GA::BinaryRepresentation<N> &other) const {
+    return !(*this == other);
+}
+
+template<size_t N>
+uint64_t GA::BinaryRepresentation<N>::getWord(size_t index) const {
+    assert(index < wordCount);
+    return words[index];
+}
+
+template<size_t N>
+void GA::BinaryRepresentation<N>::setWord(size_t index, uint64_t word) {
+    assert(index < wordCount);
+    assert(index + 1 < wordCount || (word & ~lastWordMask) == 0);
+    words[index] = word;
+}
+
+template<size_t N>
+void GA::BinaryRepresentation<N>::getWords(uint64_t *words) const {
+    std::memcpy(words, this->words, sizeof(this->words));
+}
+
+template<size_t N>
+void GA::BinaryRepresentation<N>::setWords(const uint64_t *words) {
+    std::memcpy(this->words, words, sizeof(this->words));
+    this->words[wordCount - 1] &= lastWordMask;
+}
+
+template<size_t N>
+size_t std::hash<GA::BinaryRepresentation<N>>::operator()(const GA::BinaryRepresentation<N> &individual) const noexcept {
+    uint64_t result = 0;
+    for (size_t w = 0; w < individual.getWordCount(); ++w) {
+        result = (result ^ individual.getWord(w)) * 0x9e3779b97f4a7c15;
+        result ^= result >> 32;
+    }
+    return (size_t) result;
+}
+
+inline GA::BinaryRepresentation<0>::BinaryRepresentation() : Representation(), bitCount(0), words() {
+}
+
+inline GA::BinaryRepresentation<0>::BinaryRepresentation(size_t size, unsigned long long val) :
+        Representation(), bitCount(size), words((size + 63) / 64, 0) {
+    if (!words.empty()) {
+        words[0] = (uint64_t) val;
+        this->clearUnusedBits();
+    }
+}
+
+inline void GA::BinaryRepresentation<0>::randomize(GA::RandomEngine &rnd) {
+    for (uint64_t &word: words) {
+        word = rnd();
+    }
+    this->clearUnusedBits();
+}
+
+inline size_t GA::BinaryRepresentation<0>::size() const {
+    return bitCount;
+}
+
+inline size_t GA::BinaryRepresentation<0>::getWordCount() const {
+    return words.size();
+}
+
+inline void GA::BinaryRepresentation<0>::resize(size_t size) {
+    bitCount = size;
+    words.resize((size + 63) / 64, 0);
+    this->clearUnusedBits();
+}
+
+inline bool GA::BinaryRepresentation<0>::operator[](size_t pos) const {
+    return (words[pos / 64] >> (pos % 64)) & 1;
+}
+
+inline bool GA::BinaryRepresentation<0>::test(size_t pos) const {
+    assert(pos < bitCount);
+    return (*this)[pos];
+}
+
+inline GA::BinaryRepresentation<0> &GA::BinaryRepresentation<0>::set() {
+    std::fill(words.begin(), words.end(), ~uint64_t(0));
+    this->clearUnusedBits();
+    return *this;
+}
+
+inline GA::BinaryRepresentation<0> &GA::BinaryRepresentation<0>::set(size_t pos, bool value) {
+    assert(pos < bitCount);
+    const uint64_t bit = uint64_t(1) << (pos % 64);
+    if (value) {
+        words[pos / 64] |= bit;
+    } else {
+        words[pos / 64] &= ~bit;
+    }
+    return *this;
+}
+
+inline GA::BinaryRepresentation<0> &GA::BinaryRepresentation<0>::reset() {
+    std::fill(words.begin(), words.end(), uint64_t(0));
+    return *this;
+}
+
+inline GA::BinaryRepresentation<0> &GA::BinaryRepresentation<0>::reset(size_t pos) {
+    return this->set(pos, false);
+}
+
+inline GA::BinaryRepresentation<0> &GA::BinaryRepresentation<0>::flip() {
+    for (uint64_t &word: words) {
+        word = ~word;
+    }
+    this->clearUnusedBits();
+    return *this;
+}
+
+inline GA::BinaryRepresentation<0> &GA::BinaryRepresentation<0>::flip(size_t pos) {
+    assert(pos < bitCount);
+    words[pos / 64] ^= uint64_t(1) << (pos % 64);
+    return *this;
+}
+
+inline size_t GA::BinaryRepresentation<0>::count() const {
+    size_t result = 0;
+    for (uint64_t word: words) {
+        result += (size_t) __builtin_popcountll(word);
+    }
+    return result;
+}
+
+inline bool GA::BinaryRepresentation<0>::any() const {
+    for (uint64_t word: words) {
+        if (word != 0) {
+            return true;
         }
-        ++i;
+    }
+    return false;
+}
+
+inline bool GA::BinaryRepresentation<0>::none() const {
+    return !this->any();
+}
+
+inline bool GA::BinaryRepresentation<0>::operator==(const GA::BinaryRepresentation<0> &other) const {
+    return bitCount == other.bitCount && words == other.words;
+}
+
+inline bool GA::BinaryRepresentation<0>::operator!=(const GA::BinaryRepresentation<0> &other) const {
+    return !(*this == other);
+}
+
+inline uint64_t GA::BinaryRepresentation<0>::getWord(size_t index) const {
+    assert(index < words.size());
+    return words[index];
+}
+
+inline void GA::BinaryRepresentation<0>::setWord(size_t index, uint64_t word) {
+    assert(index < words.size());
+    assert(index + 1 < words.size() || bitCount % 64 == 0 || (word >> (bitCount % 64)) == 0);
+    words[index] = word;
+}
+
+inline void GA::BinaryRepresentation<0>::getWords(uint64_t *words) const {
+    std::copy(this->words.begin(), this->words.end(), words);
+}
+
+inline void GA::BinaryRepresentation<0>::setWords(const uint64_t *words) {
+    std::copy(words, words + this->words.size(), this->words.begin());
+    this->clearUnusedBits();
+}
+
+inline void GA::BinaryRepresentation<0>::clearUnusedBits() {
+    if (bitCount % 64 != 0) {
+        words.back() &= (uint64_t(1) << (bitCount % 64)) - 1;
     }
 }
@@ -19,16 +19,16 @@ void GA::ElitismSelection<Individual>::setProportionSurvival(double proportionSu
 
 template<class Individual>
 typename GA::ElitismSelection<Individual>::Population GA::ElitismSelection<Individual>::operator()
-        (const GA::ElitismSelection<Individual>::Population &population) {
+        (const GA::ElitismSelection<Individual>::Population &population, GA::RandomEngine &) {
+    assert(population.isSorted());
     Population out;
     size_t countToSave = (size_t) ((double) population.size() * proportionSurvival);
     if (countToSave < 1) {
         countToSave = 1;
     }
-    auto it = population.begin();
-    for (; countToSave > 0; --countToSave) {
-        out.emplace(it->first, it->second);
-        it++;
+    out.reserve(countToSave);
+    for (size_t i = 0; i < countToSave; ++i) {
+        out.add(population.getScore(i), population.getIndividual(i));
     }
     return out;
 }
@@ -3,19 +3,16 @@
 
 template<class Individual>
 typename GA::ProbabilistSelection<Individual>::Population GA::ProbabilistSelection<Individual>::operator()
-        (const GA::ProbabilistSelection<Individual>::Population &population) {
-    std::random_device rndDevice;
-    std::default_random_engine rnd(rndDevice());
+        (const GA::ProbabilistSelection<Individual>::Population &population, GA::RandomEngine &rnd) {
     std::uniform_real_distribution<double> distrib(0., 1.);
 
+    assert(population.isSorted());
     Population out;
-    auto it = population.begin();
     double size = (double) population.size();
     for (size_t i = 0; i < population.size(); i++) {
         if (distrib(rnd) > (double) i / size) {
-            out.emplace(it->first, it->second);
+            out.add(population.getScore(i), population.getIndividual(i));
         }
-        ++it;
     }
     return out;
 }
@@ -0,0 +1,115 @@
+#include <algorithm> // copy, sort
+#include <cassert>
+#include <cmath> // sqrt
+#include <GA/Statistics.h>
+
+inline GA::RunningStatistics::RunningStatistics() :
+        count(0),
+        mean(0.),
+        squaredDeviations(0.) {
+}
+
+inline void GA::RunningStatistics::add(double value) {
+    ++count;
+    double delta = value - mean;
+    mean += delta / (double) count;
+    squaredDeviations += delta * (value - mean);
+}
+
+inline size_t GA::RunningStatistics::getCount() const {
+    return count;
+}
+
+inline double GA::RunningStatistics::getMean() const {
+    return mean;
+}
+
+inline double GA::RunningStatistics::getStandardDeviation() const {
+    return count < 2 ? 0. : std::sqrt(squaredDeviations / (double) count);
+}
+
+inline GA::QuantileEstimator::QuantileEstimator(double probability) :
+        probability(probability),
+        count(0),
+        heights(),
+        positions{1., 2., 3., 4., 5.},
+        desired{1., 1. + 2. * probability, 1. + 4. * probability, 3. + 2. * probability, 5.},
+        increments{0., probability / 2., probability, (1. + probability) / 2., 1.} {
+    assert(0. <= probability && probability <= 1.);
+}
+
+inline void GA::QuantileEstimator::add(double value) {
+    if (count < 5) {
+        heights[count++] = value;
+        if (count == 5) {
+            std::sort(heights, heights + 5);
+        }
+        return;
+    }
+    ++count;
+
+    // Cell of the value, extending the extrema if needed
+    size_t k;
+    if (value < heights[0]) {
+        heights[0] = value;
+        k = 0;
+    } else if (value >= heights[4]) {
+        heights[4] = value;
+        k = 3;
+    } else {
+        k = 0;
+        while (value >= heights[k + 1]) {
+            ++k;
+        }
+    }
+    for (size_t i = k + 1; i < 5; ++i) {
+        positions[i] += 1.;
+    }
+    for (size_t i = 0; i < 5; ++i) {
+        desired[i] += increments[i];
+    }
+
+    // Move the inner markers toward their desired positions
+    for (size_t i = 1; i < 4; ++i) {
+        double gap = desired[i] - positions[i];
+        if ((gap >= 1. && positions[i + 1] - positions[i] > 1.) || (gap <= -1. && positions[i - 1] - positions[i] < -1.)) {
+            double d = gap >= 1. ? 1. : -1.;
+            double height = this->parabolic(i, d);
+            if (!(heights[i - 1] < height && height < heights[i + 1])) {
+                height = this->linear(i, d);
+            }
+            heights[i] = height;
+            positions[i] += d;
+        }
+    }
+}
+
+inline size_t GA::QuantileEstimator::getCount() const {
+    return count;
+}
+
+inline double GA::QuantileEstimator::getQuantile() const {
+    if (count == 0) {
+        return 0.;
+    }
+    if (count <= 5) {
+        // Exact quantile of the few values, by nearest rank
+        double sorted[5];
+        std::copy(heights, heights + count, sorted);
+        std::sort(sorted, sorted + count);
+        return sorted[(size_t) std::lround(probability * (double) (count - 1))];
+    }
+    return heights[2];
+}
+
+inline double GA::QuantileEstimator::parabolic(size_t i, double d) const {
+    const double n = positions[i], nPrevious = positions[i - 1], nNext = positions[i + 1];
+    return heights[i] + d / (nNext - nPrevious) * (
+            (n - nPrevious + d) * (heights[i + 1] - heights[i]) / (nNext - n)
+            + (nNext - n - d) * (heights[i] - heights[i - 1]) / (n - nPrevious));
+}
+
+inline double GA::QuantileEstimator::linear(size_t i, double d) const {
+    size_t j = d > 0. ? i + 1 : i - 1;
+    return heights[i] + d * (heights[j] - heights[i]) / (positions[j] - positions[i]);
+}
@@ -0,0 +1,185 @@
+#include <algorithm> // max, min
+#include <cassert>
+#include <GA/Termination.h>
+
+inline GA::Termination::Termination() :
+        criteria(0),
+        combination(Combination::AnyOf),
+        timeLimit(0.),
+        cpuTimeLimit(0.),
+        generationLimit(0),
+        evaluationLimit(0),
+        targetScore(0.),
+        stallLimit(0),
+        timeResolution(1e-3),
+        startTime(),
+        startCpuTime(0.),
+        startGeneration(0),
+        startEvaluations(0),
+        nextClockCheck(0),
+        timeReached(false),
+        cpuTimeReached(false),
+        bestScore(0.),
+        lastImprovement(0) {
+}
+
+inline unsigned int GA::Termination::getCriteria() const {
+    return criteria;
+}
+
+inline GA::Termination::Combination GA::Termination::getCombination() const {
+    return combination;
+}
+
+inline double GA::Termination::getTimeLimit() const {
+    return timeLimit;
+}
+
+inline double GA::Termination::getCpuTimeLimit() const {
+    return cpuTimeLimit;
+}
+
+inline unsigned long GA::Termination::getGenerationLimit() const {
+    return generationLimit;
+}
+
+inline unsigned long GA::Termination::getEvaluationLimit() const {
+    return evaluationLimit;
+}
+
+inline double GA::Termination::getTargetScore() const {
+    return targetScore;
+}
+
+inline unsigned long GA::Termination::getStallLimit() const {
+    return stallLimit;
+}
+
+inline double GA::Termination::getTimeResolution() const {
+    return timeResolution;
+}
+
+inline void GA::Termination::setCombination(Combination combination) {
+    this->combination = combination;
+}
+
+inline void GA::Termination::setTimeLimit(double seconds) {
+    this->timeLimit = seconds;
+    criteria |= Time;
+}
+
+inline void GA::Termination::setCpuTimeLimit(double seconds) {
+    this->cpuTimeLimit = seconds;
+    criteria |= CpuTime;
+}
+
+inline void GA::Termination::setGenerationLimit(unsigned long generations) {
+    this->generationLimit = generations;
+    criteria |= Generations;
+}
+
+inline void GA::Termination::setEvaluationLimit(unsigned long evaluations) {
+    this->evaluationLimit = evaluations;
+    criteria |= Evaluations;
+}
+
+inline void GA::Termination::setTargetScore(double score) {
+    this->targetScore = score;
+    criteria |= TargetScore;
+}
+
+inline void GA::Termination::setStallLimit(unsigned long generations) {
+    this->stallLimit = generations;
+    criteria |= Stall;
+}
+
+inline void GA::Termination::setTimeResolution(double seconds) {
+    assert(seconds > 0.);
+    this->timeResolution = seconds;
+}
+
+inline void GA::Termination::clear(Criterion criterion) {
+    criteria &= ~(unsigned int) criterion;
+}
+
+inline void GA::Termination::start(unsigned long generation, unsigned long evaluations, double score) {
+    assert(criteria != 0);
+    startTime = Clock::now();
+    startCpuTime = (criteria & CpuTime) ? getThreadCpuTime() : 0.;
+    startGeneration = generation;
+    startEvaluations = evaluations;
+    nextClockCheck = generation + 1;
+    timeReached = false;
+    cpuTimeReached = false;
+    bestScore = score;
+    lastImprovement = generation;
+}
+
+inline unsigned int GA::Termination::check(unsigned long generation, unsigned long evaluations, double score) {
+    if (score < bestScore) {
+        bestScore = score;
+        lastImprovement = generation;
+    }
+
+    unsigned int reached = 0;
+    if ((criteria & Generations) && generation - startGeneration >= generationLimit) {
+        reached |= Generations;
+    }
+    if ((criteria & Evaluations) && evaluations - startEvaluations >= evaluationLimit) {
+        reached |= Evaluations;
+    }
+    if ((criteria & TargetScore) && score <= targetScore) {
+        reached |= TargetScore;
+    }
+    if ((criteria & Stall) && generation - lastImprovement >= stallLimit) {
+        reached |= Stall;
+    }
+    if ((criteria & (Time | CpuTime)) && generation >= nextClockCheck) {
+        this->checkClocks(generation);
+    }
+    if (timeReached) {
+        reached |= Time;
+    }
+    if (cpuTimeReached) {
+        reached |= CpuTime;
+    }
+
+    bool done = combination == Combination::AnyOf ? reached != 0 : reached == criteria;
+    return done ? reached : 0;
+}
+
+inline double GA::Termination::getThreadCpuTime() {
+    timespec time;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return (double) time.tv_sec + (double) time.tv_nsec * 1e-9;
+}
+
+inline void GA::Termination::checkClocks(unsigned long generation) {
+    // Read the clocks again once about timeResolution has passed, at the current speed
+    const double generations = (double) (generation - startGeneration);
+    unsigned long interval = ~0ul;
+    auto schedule = [this, generations, &interval](double elapsed, double limit) {
+        double horizon = std::min(limit - elapsed, timeResolution);
+        double speed = elapsed > 0. ? generations / elapsed : 0.;
+        interval = std::min(interval, std::max(1ul, (unsigned long) (speed * horizon)));
+    };
+    if ((criteria & Time) && !timeReached) {
+        double elapsed = Duration(Clock::now() - startTime).count();
+        if (elapsed >= timeLimit) {
+            timeReached = true;
+        } else {
+            schedule(elapsed, timeLimit);
+        }
+    }
+    if ((criteria & CpuTime) && !cpuTimeReached) {
+        double elapsed = getThreadCpuTime() - startCpuTime;
+        if (elapsed >= cpuTimeLimit) {
+            cpuTimeReached = true;
+        } else {
+            schedule(elapsed, cpuTimeLimit);
+        }
+    }
+    if (interval != ~0ul) {
+        nextClockCheck = generation + interval;
+    }
+}
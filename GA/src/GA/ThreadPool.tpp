@@ -0,0 +1,129 @@
+#include <algorithm> // min
+#include <atomic>
+#include <memory> // make_shared
+#include <GA/ThreadPool.h>
+
+inline GA::ThreadPool::ThreadPool(size_t threadCount) :
+        workers(),
+        tasks(),
+        pending(0),
+        stopping(false) {
+    for (size_t i = 1; i < threadCount; ++i) {
+        workers.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+inline GA::ThreadPool::~ThreadPool() {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        taskDone.wait(lock, [this]() { return pending == 0; });
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+    for (std::thread &worker: workers) {
+        worker.join();
+    }
+}
+
+inline GA::ThreadPool &GA::ThreadPool::shared() {
+    static ThreadPool pool(std::thread::hardware_concurrency());
+    return pool;
+}
+
+inline size_t GA::ThreadPool::getThreadCount() const {
+    return workers.size() + 1;
+}
+
+inline void GA::ThreadPool::submit(std::function<void()> task) {
+    if (workers.empty()) {
+        task();
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(std::move(task));
+        ++pending;
+    }
+    taskAvailable.notify_one();
+}
+
+inline void GA::ThreadPool::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    taskDone.wait(lock, [this]() { return pending == 0; });
+}
+
+template<class Function>
+void GA::ThreadPool::parallelFor(size_t begin, size_t end, Function function, size_t grain) {
+    if (begin >= end) {
+        return;
+    }
+    if (grain == 0) {
+        grain = (end - begin + 63) / 64;
+    }
+    const size_t chunkCount = (end - begin + grain - 1) / grain;
+
+    if (workers.empty() || chunkCount == 1) {
+        for (size_t first = begin; first < end; first += grain) {
+            function(first, std::min(first + grain, end));
+        }
+        return;
+    }
+
+    struct State {
+        std::atomic<size_t> next;
+        std::atomic<size_t> done;
+        std::mutex mutex;
+        std::condition_variable finished;
+    };
+    std::shared_ptr<State> state = std::make_shared<State>();
+    state->next = 0;
+    state->done = 0;
+
+    /*
+     * Helpers which start after the last chunk has been taken return without touching
+     * the function, so it is safe to capture it by reference: the calling thread does
+     * not return before every taken chunk is done.
+     */
+    auto run = [state, begin, end, grain, chunkCount, &function]() {
+        size_t chunk;
+        while ((chunk = state->next++) < chunkCount) {
+            size_t first = begin + chunk * grain;
+            function(first, std::min(first + grain, end));
+            if (++state->done == chunkCount) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->finished.notify_all();
+            }
+        }
+    };
+
+    size_t helperCount = std::min(workers.size(), chunkCount - 1);
+    for (size_t i = 0; i < helperCount; ++i) {
+        this->submit(run);
+    }
+    run();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&state, chunkCount]() { return state->done == chunkCount; });
+}
+
+inline void GA::ThreadPool::work() {
+    std::function<void()> task;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            taskAvailable.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pending == 0) {
+                taskDone.notify_all();
+            }
+        }
+    }
+}
@@ -0,0 +1,289 @@
+#include <cassert>
+#include <cstdint> // uintptr_t
+#include <GA/Trace.h>
+
+inline size_t GA::TraceColumns::size() const {
+    return times.size();
+}
+
+inline void GA::TraceColumns::clear() {
+    times.clear();
+    evaluations.clear();
+    best.clear();
+    mean.clear();
+}
+
+inline GA::TraceWriter::TraceWriter() :
+        file(),
+        interval(0.),
+        hasKept(false),
+        lastKeptTime(0.),
+        hasDropped(false),
+        droppedTime(0.),
+        droppedEvaluations(0),
+        droppedBest(0.),
+        droppedMean(0.),
+        current(),
+        flushing(),
+        flushPending(false),
+        stopping(false),
+        failed(false),
+        writer() {
+}
+
+inline GA::TraceWriter::~TraceWriter() {
+    if (this->isOpen()) {
+        this->close();
+    }
+}
+
+inline bool GA::TraceWriter::open(const std::string &filename) {
+    assert(!this->isOpen());
+    file.open(filename, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        return false;
+    }
+    const uint64_t header[] = {magic, version};
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+    hasKept = false;
+    hasDropped = false;
+    for (TraceColumns *block: {&current, &flushing}) {
+        block->clear();
+        block->times.reserve(blockSize);
+        block->evaluations.reserve(blockSize);
+        block->best.reserve(blockSize);
+        block->mean.reserve(blockSize);
+    }
+    flushPending = false;
+    stopping = false;
+    failed = !file;
+    writer = std::thread(&TraceWriter::work, this);
+    return true;
+}
+
+inline bool GA::TraceWriter::isOpen() const {
+    return writer.joinable();
+}
+
+inline double GA::TraceWriter::getInterval() const {
+    return interval;
+}
+
+inline void GA::TraceWriter::setInterval(double interval) {
+    assert(interval >= 0.);
+    this->interval = interval;
+}
+
+inline void GA::TraceWriter::record(double time, uint64_t evaluations, double best, double mean) {
+    assert(this->isOpen());
+    if (this->isDropped(time)) {
+        this->hold(time, evaluations, best, mean);
+        return;
+    }
+    this->append(time, evaluations, best, mean);
+    hasKept = true;
+    lastKeptTime = time;
+    hasDropped = false;
+}
+
+template<class Engine>
+void GA::TraceWriter::record(double time, const Engine &engine) {
+    assert(this->isOpen());
+    if (this->isDropped(time)) {
+        // The last state is kept by finish
+        hasDropped = false;
+        return;
+    }
+    this->record(time, engine.getEvaluationCount(), engine.getScore(), getMean(engine));
+}
+
+template<class Engine>
+void GA::TraceWriter::finish(double time, const Engine &engine) {
+    assert(this->isOpen());
+    assert(!hasKept || time >= lastKeptTime);
+    hasDropped = false;
+    if (hasKept && time <= lastKeptTime) {
+        return;
+    }
+    this->append(time, engine.getEvaluationCount(), engine.getScore(), getMean(engine));
+    hasKept = true;
+    lastKeptTime = time;
+}
+
+inline bool GA::TraceWriter::isDropped(double time) const {
+    return hasKept && time < lastKeptTime + interval;
+}
+
+inline void GA::TraceWriter::hold(double time, uint64_t evaluations, double best, double mean) {
+    droppedTime = time;
+    droppedEvaluations = evaluations;
+    droppedBest = best;
+    droppedMean = mean;
+    hasDropped = true;
+}
+
+template<class Engine>
+double GA::TraceWriter::getMean(const Engine &engine) {
+    const std::vector<double> &scores = engine.getPopulation().getScores();
+    double sum = 0.;
+    for (double score: scores) {
+        sum += score;
+    }
+    return scores.empty() ? engine.getScore() : sum / (double) scores.size();
+}
+
+inline bool GA::TraceWriter::close() {
+    assert(this->isOpen());
+    if (hasDropped) {
+        this->append(droppedTime, droppedEvaluations, droppedBest, droppedMean);
+        hasDropped = false;
+    }
+    if (current.size() != 0) {
+        this->submit();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    changed.notify_all();
+    writer.join();
+
+    file.close();
+    return !failed && !file.fail();
+}
+
+inline void GA::TraceWriter::append(double time, uint64_t evaluations, double best, double mean) {
+    current.times.push_back(time);
+    current.evaluations.push_back(evaluations);
+    current.best.push_back(best);
+    current.mean.push_back(mean);
+    if (current.size() == blockSize) {
+        this->submit();
+    }
+}
+
+inline void GA::TraceWriter::submit() {
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [this]() { return !flushPending; });
+        std::swap(current, flushing);
+        flushPending = true;
+    }
+    changed.notify_all();
+}
+
+inline void GA::TraceWriter::work() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        changed.wait(lock, [this]() { return flushPending || stopping; });
+        if (!flushPending) {
+            return;
+        }
+
+        // The block belongs to this thread until flushPending is reset
+        lock.unlock();
+        const uint64_t count = flushing.size();
+        const std::streamsize doubles = (std::streamsize) (count * sizeof(double));
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        file.write(reinterpret_cast<const char*>(flushing.times.data()), doubles);
+        file.write(reinterpret_cast<const char*>(flushing.evaluations.data()), (std::streamsize) (count * sizeof(uint64_t)));
+        file.write(reinterpret_cast<const char*>(flushing.best.data()), doubles);
+        file.write(reinterpret_cast<const char*>(flushing.mean.data()), doubles);
+        bool writeFailed = !file;
+        flushing.clear();
+        lock.lock();
+
+        failed = failed || writeFailed;
+        flushPending = false;
+        changed.notify_all();
+    }
+}
+
+inline bool GA::TraceReader::load(const std::string &filename) {
+    columns.clear();
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    const uint64_t fileSize = (uint64_t) file.tellg();
+    file.seekg(0);
+
+    uint64_t header[2];
+    if (fileSize < sizeof(header) || !file.read(reinterpret_cast<char*>(header), sizeof(header))
+        || header[0] != TraceWriter::magic || header[1] != TraceWriter::version) {
+        return false;
+    }
+
+    uint64_t remaining = fileSize - sizeof(header);
+    const uint64_t sampleSize = 3 * sizeof(double) + sizeof(uint64_t);
+    while (remaining != 0) {
+        uint64_t count;
+        if (remaining < sizeof(count) || !file.read(reinterpret_cast<char*>(&count), sizeof(count))) {
+            columns.clear();
+            return false;
+        }
+        remaining -= sizeof(count);
+        // The size is checked against the file before any allocation
+        if (count > remaining / sampleSize) {
+            columns.clear();
+            return false;
+        }
+        remaining -= count * sampleSize;
+
+        const size_t offset = columns.size();
+        const size_t size = offset + count;
+        columns.times.resize(size);
+        columns.evaluations.resize(size);
+        columns.best.resize(size);
+        columns.mean.resize(size);
+        const std::streamsize doubles = (std::streamsize) (count * sizeof(double));
+        file.read(reinterpret_cast<char*>(columns.times.data() + offset), doubles);
+        file.read(reinterpret_cast<char*>(columns.evaluations.data() + offset), (std::streamsize) (count * sizeof(uint64_t)));
+        file.read(reinterpret_cast<char*>(columns.best.data() + offset), doubles);
+        file.read(reinterpret_cast<char*>(columns.mean.data() + offset), doubles);
+        if (!file) {
+            columns.clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+inline size_t GA::TraceReader::size() const {
+    return columns.size();
+}
+
+inline const GA::TraceColumns &GA::TraceReader::getColumns() const {
+    return columns;
+}
+
+template<class Function>
+bool GA::TraceReader::parse(const char *data, size_t size, Function function) {
+    assert(reinterpret_cast<uintptr_t>(data) % sizeof(uint64_t) == 0);
+    const uint64_t *header = reinterpret_cast<const uint64_t*>(data);
+    if (size < 2 * sizeof(uint64_t) || header[0] != TraceWriter::magic || header[1] != TraceWriter::version) {
+        return false;
+    }
+
+    const size_t sampleSize = 3 * sizeof(double) + sizeof(uint64_t);
+    size_t offset = 2 * sizeof(uint64_t);
+    while (offset != size) {
+        if (size - offset < sizeof(uint64_t)) {
+            return false;
+        }
+        const uint64_t count = *reinterpret_cast<const uint64_t*>(data + offset);
+        offset += sizeof(uint64_t);
+        if (count > (size - offset) / sampleSize) {
+            return false;
+        }
+        const size_t columnSize = count * sizeof(double);
+        function(count,
+                 reinterpret_cast<const double*>(data + offset),
+                 reinterpret_cast<const uint64_t*>(data + offset + columnSize),
+                 reinterpret_cast<const double*>(data + offset + 2 * columnSize),
+                 reinterpret_cast<const double*>(data + offset + 3 * columnSize));
+        offset += 4 * columnSize;
+    }
+    return true;
+}
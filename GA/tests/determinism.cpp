@@ -0,0 +1,69 @@
+#include <iostream>
+#include <vector>
+#include "FacilityLocation/Objective.h"
+#include "GA/Engine.h"
+#include "GA/Crossover/SinglePointCrossover.h"
+#include "GA/Mutation/RandomMutation.h"
+#include "GA/Selection/ElitismSelection.h"
+
+/*
+ * Run a seeded engine with 1 thread and with several threads, and check that the
+ * scores of every generation are identical, for both replacements. Children close to
+ * their parents are scored incrementally by the objective, in batches that depend on
+ * the number of threads.
+ */
+
+#define NF 100 // Number of facilities
+#define NC 500 // Number of customers
+#define SEED 7 // Seed of the instance and of the engines
+#define POPULATION 128 // Size of the population
+#define GENERATIONS 40 // Number of generations of a run
+#define THREADS 4 // Number of threads of the parallel run
+
+using Individual = GA::BinaryRepresentation<NF>;
+using Engine = GA::Engine<Individual>;
+
+static std::vector<double> run(FacilityLocation::Objective<Individual> &objective, Engine::Replacement replacement,
+                               size_t threadCount) {
+    GA::SinglePointCrossover<Individual> crossover;
+    GA::RandomMutation<Individual> mutation(1. / NF);
+    GA::ElitismSelection<Individual> selection(0.05);
+    Engine engine(objective, crossover, mutation, selection);
+    engine.setReplacement(replacement);
+    engine.setOffspringCount(POPULATION / 2);
+    engine.setThreadCount(threadCount);
+    engine.setSeed(SEED);
+    engine.initialize(POPULATION);
+
+    std::vector<double> scores;
+    for (unsigned int generation = 0; generation < GENERATIONS; ++generation) {
+        engine.step(1);
+        const std::vector<double> &population = engine.getPopulation().getScores();
+        scores.insert(scores.end(), population.begin(), population.end());
+    }
+    return scores;
+}
+
+int main() {
+    auto instance = FacilityLocation::Instance<NF>::randomInstance(NC, SEED);
+    FacilityLocation::Objective<Individual> objective(instance);
+
+    int result = 0;
+    for (Engine::Replacement replacement: {Engine::Replacement::Generational, Engine::Replacement::SteadyState}) {
+        const std::vector<double> serial = run(objective, replacement, 1);
+        const std::vector<double> parallel = run(objective, replacement, THREADS);
+        size_t differences = 0;
+        for (size_t i = 0; i < serial.size(); ++i) {
+            // Bit-identical scores are expected, not close ones
+            if (serial[i] < parallel[i] || parallel[i] < serial[i]) {
+                ++differences;
+            }
+        }
+        const char *name = replacement == Engine::Replacement::Generational ? "generational" : "steady-state";
+        std::cout << name << ": " << differences << " of " << serial.size() << " scores differ" << std::endl;
+        if (differences != 0 || serial.size() != parallel.size()) {
+            result = 1;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,362 @@
+#include <algorithm> // sort
+#include <array>
+#include <cstring> // strcmp
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <dirent.h> // opendir
+#include <fcntl.h> // open
+#include <sys/mman.h> // mmap
+#include <sys/stat.h> // fstat
+#include <unistd.h> // close
+#include "GA/Statistics.h"
+#include "GA/ThreadPool.h"
+#include "GA/Trace.h"
+
+/*
+ * Aggregate the traces of the experiment runner, found in
+ * ROOT/instance/experiment/configuration/r.trace.
+ *
+ * The duration of a run is split in time steps. Within a step, the best score of a
+ * replicate is fitted by a linear regression, whose value at the beginning of the
+ * step is kept. Over the replicates of a configuration, these values give the
+ * columns of the file stats of the configuration: time, mean-2sd, mean-sd, mean,
+ * mean+sd, mean+2sd, then the 2.5%, 25%, 50%, 75% and 97.5% quantiles. Every
+ * configuration is compared to the configuration no-redundancy/0 of its instance,
+ * and a gnuplot script showing both is written in the file plotscript.
+ *
+ * Traces are read in one pass from memory mapped files, and configurations are
+ * processed in parallel.
+ *
+ * Usage: aggregate [--steps COUNT] [--duration SECONDS] [--threads COUNT] [ROOT]
+ * By default, 30 steps over 1 second, one thread per hardware thread, ROOT is output.
+ */
+
+namespace {
+
+    using Row = std::array<double, 11>;
+
+    const double quantileProbabilities[] = {0.025, 0.25, 0.5, 0.75, 0.975};
+
+    /**
+     * Options of the command line.
+     */
+    struct Options {
+        size_t steps; /**< Number of time steps */
+        double duration; /**< Duration covered by the steps, in seconds */
+        size_t threads; /**< Number of threads, 0 for every hardware thread */
+        std::string root; /**< Directory of the results */
+    };
+
+    /**
+     * The results of a configuration.
+     */
+    struct Summary {
+        std::string path; /**< Directory of the configuration, ending with '/' */
+        size_t fileCount; /**< Number of traces found */
+        std::vector<Row> rows; /**< Lines of the stats file */
+    };
+
+    /**
+     * Values of the steps over the replicates of a configuration.
+     */
+    struct Step {
+        GA::RunningStatistics statistics; /**< Mean and deviation of the values */
+        std::vector<GA::QuantileEstimator> quantiles; /**< Quantiles of the values */
+    };
+
+    /**
+     * Piecewise linear regression of the best score of one trace, fed sample by sample.
+     */
+    class StepRegression final {
+
+    public:
+        StepRegression(std::vector<Step> &steps, double stepDuration) :
+                steps(steps),
+                stepDuration(stepDuration),
+                upperBound(stepDuration),
+                index(0),
+                sumX(0.), sumY(0.), sumXX(0.), sumXY(0.), count(0) {
+        }
+
+        void add(double x, double y) {
+            if (index >= steps.size()) {
+                return;
+            }
+            if (x > upperBound) {
+                // Value at the beginning of the step, or the sample if it can't be fitted
+                double value = y;
+                double denominator = (double) count * sumXX - sumX * sumX;
+                if (count > 1 && denominator > 0.) {
+                    double beta = ((double) count * sumXY - sumX * sumY) / denominator;
+                    value = sumY / (double) count - beta * sumX / (double) count;
+                } else if (count > 1) {
+                    value = sumY / (double) count;
+                }
+                steps[index].statistics.add(value);
+                for (GA::QuantileEstimator &quantile: steps[index].quantiles) {
+                    quantile.add(value);
+                }
+                upperBound += stepDuration;
+                ++index;
+                if (index >= steps.size()) {
+                    return;
+                }
+                sumX = sumY = sumXX = sumXY = 0.;
+                count = 0;
+            }
+            double dx = x - (double) index * stepDuration;
+            sumX += dx;
+            sumY += y;
+            sumXX += dx * dx;
+            sumXY += dx * y;
+            ++count;
+        }
+
+    private:
+        std::vector<Step> &steps;
+        const double stepDuration;
+        double upperBound;
+        size_t index;
+        double sumX, sumY, sumXX, sumXY;
+        size_t count;
+
+    };
+
+    /**
+     * Feed the samples of a trace file to a regression.
+     * The file is mapped in memory, or loaded if it can not be mapped.
+     * @return false if the file is not a valid trace
+     */
+    bool readTrace(const std::string &filename, StepRegression &regression) {
+        auto visit = [&regression](size_t count, const double *times, const uint64_t *, const double *best,
+                                   const double *) {
+            for (size_t i = 0; i < count; ++i) {
+                regression.add(times[i], best[i]);
+            }
+        };
+
+        int descriptor = open(filename.c_str(), O_RDONLY);
+        if (descriptor >= 0) {
+            struct stat status;
+            void *data = MAP_FAILED;
+            size_t size = 0;
+            if (fstat(descriptor, &status) == 0 && status.st_size > 0) {
+                size = (size_t) status.st_size;
+                data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            }
+            close(descriptor);
+            if (data != MAP_FAILED) {
+                madvise(data, size, MADV_SEQUENTIAL);
+                bool valid = GA::TraceReader::parse(static_cast<const char*>(data), size, visit);
+                munmap(data, size);
+                return valid;
+            }
+        }
+
+        GA::TraceReader reader;
+        if (!reader.load(filename)) {
+            return false;
+        }
+        const GA::TraceColumns &columns = reader.getColumns();
+        visit(columns.size(), columns.times.data(), columns.evaluations.data(), columns.best.data(),
+              columns.mean.data());
+        return true;
+    }
+
+    bool isFile(const std::string &path) {
+        struct stat status;
+        return stat(path.c_str(), &status) == 0 && S_ISREG(status.st_mode);
+    }
+
+    /**
+     * @return The sorted names of the sub-directories of a directory
+     */
+    std::vector<std::string> listDirectories(const std::string &path) {
+        std::vector<std::string> names;
+        DIR *directory = opendir(path.c_str());
+        if (directory == nullptr) {
+            return names;
+        }
+        while (dirent *entry = readdir(directory)) {
+            std::string name = entry->d_name;
+            struct stat status;
+            if (name != "." && name != ".." && stat((path + "/" + name).c_str(), &status) == 0
+                && S_ISDIR(status.st_mode)) {
+                names.push_back(name);
+            }
+        }
+        closedir(directory);
+        std::sort(names.begin(), names.end());
+        return names;
+    }
+
+    void summarize(Summary &summary, const Options &options) {
+        const double stepDuration = options.duration / (double) options.steps;
+        std::vector<Step> steps(options.steps);
+        for (Step &step: steps) {
+            for (double probability: quantileProbabilities) {
+                step.quantiles.emplace_back(probability);
+            }
+        }
+
+        summary.fileCount = 0;
+        while (isFile(summary.path + std::to_string(summary.fileCount) + ".trace")) {
+            ++summary.fileCount;
+        }
+        for (size_t i = 0; i < summary.fileCount; ++i) {
+            const std::string filename = summary.path + std::to_string(i) + ".trace";
+            StepRegression regression(steps, stepDuration);
+            if (!readTrace(filename, regression)) {
+                std::cerr << filename << " is not a valid trace" << std::endl;
+            }
+        }
+
+        for (size_t i = 0; i < steps.size(); ++i) {
+            const GA::RunningStatistics &statistics = steps[i].statistics;
+            if (statistics.getCount() < 2) {
+                continue;
+            }
+            double mean = statistics.getMean();
+            double sd = statistics.getStandardDeviation();
+            Row row = {{(double) i * stepDuration, mean - 2 * sd, mean - sd, mean, mean + sd, mean + 2 * sd,
+                        0., 0., 0., 0., 0.}};
+            for (size_t q = 0; q < steps[i].quantiles.size(); ++q) {
+                row[6 + q] = steps[i].quantiles[q].getQuantile();
+            }
+            summary.rows.push_back(row);
+        }
+
+        if (summary.fileCount > 0) {
+            std::ofstream file(summary.path + "stats");
+            if (!file.is_open()) {
+                std::cerr << "Can't open file " << summary.path << "stats" << std::endl;
+                return;
+            }
+            file.precision(12);
+            for (const Row &row: summary.rows) {
+                for (size_t j = 0; j < row.size(); ++j) {
+                    file << (j == 0 ? "" : " ") << row[j];
+                }
+                file << "\n";
+            }
+        }
+    }
+
+    /**
+     * Print how far a configuration is above or below the reference, past the first step.
+     */
+    void compare(const Summary &reference, const Summary &test) {
+        double betterTest = 0.;
+        double worseTest = 0.;
+        for (size_t i = 1; i < reference.rows.size() && i < test.rows.size(); ++i) {
+            const Row &r = reference.rows[i];
+            const Row &t = test.rows[i];
+            if (r[1] > t[3]) {
+                betterTest += r[1] - t[3];
+            }
+            if (t[1] > r[3]) {
+                worseTest += t[1] - r[3];
+            }
+        }
+        std::cout << test.path << ":" << betterTest << " " << worseTest << std::endl;
+    }
+
+    bool parseOptions(int argc, char **argv, Options &options) {
+        options.steps = 30;
+        options.duration = 1.;
+        options.threads = 0;
+        options.root = "output";
+        for (int i = 1; i < argc; ++i) {
+            bool hasValue = i + 1 < argc;
+            if (std::strcmp(argv[i], "--steps") == 0 && hasValue) {
+                options.steps = (size_t) std::atol(argv[++i]);
+            } else if (std::strcmp(argv[i], "--duration") == 0 && hasValue) {
+                options.duration = std::atof(argv[++i]);
+            } else if (std::strcmp(argv[i], "--threads") == 0 && hasValue) {
+                options.threads = (size_t) std::atol(argv[++i]);
+            } else if (argv[i][0] != '-') {
+                options.root = argv[i];
+            } else {
+                return false;
+            }
+        }
+        return options.steps > 0 && options.duration > 0.;
+    }
+
+}
+
+int main(int argc, char **argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0] << " [--steps COUNT] [--duration SECONDS] [--threads COUNT] [ROOT]"
+                  << std::endl;
+        return 1;
+    }
+
+    std::vector<std::string> instances = listDirectories(options.root);
+    std::vector<Summary> summaries;
+    for (const std::string &instance: instances) {
+        for (const std::string &test: listDirectories(options.root + "/" + instance)) {
+            for (const std::string &value: listDirectories(options.root + "/" + instance + "/" + test)) {
+                Summary summary;
+                summary.path = options.root + "/" + instance + "/" + test + "/" + value + "/";
+                summaries.push_back(summary);
+            }
+        }
+    }
+
+    size_t threads = options.threads != 0 ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+    GA::ThreadPool threadPool(threads);
+    threadPool.parallelFor(0, summaries.size(), [&summaries, &options](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            summarize(summaries[i], options);
+        }
+    }, 1);
+    for (const Summary &summary: summaries) {
+        std::cout << summary.path << " (" << summary.fileCount << " files found)" << std::endl;
+    }
+
+    std::ofstream plotscript("plotscript");
+    if (!plotscript.is_open()) {
+        std::cerr << "Can't open file plotscript" << std::endl;
+        return 1;
+    }
+    for (const std::string &instance: instances) {
+        const std::string referencePath = options.root + "/" + instance + "/no-redundancy/0/";
+        const Summary *reference = nullptr;
+        for (const Summary &summary: summaries) {
+            if (summary.path == referencePath && summary.fileCount > 0) {
+                reference = &summary;
+            }
+        }
+        if (reference == nullptr) {
+            std::cerr << "No reference " << referencePath << " for " << instance << std::endl;
+            continue;
+        }
+
+        for (const std::string &test: listDirectories(options.root + "/" + instance)) {
+            plotscript << "set title \"" << instance << "\"\n";
+            const std::string testPath = options.root + "/" + instance + "/" + test + "/";
+            for (const Summary &summary: summaries) {
+                if (summary.path.compare(0, testPath.size(), testPath) != 0 || summary.fileCount == 0) {
+                    continue;
+                }
+                compare(*reference, summary);
+                const std::string value = summary.path.substr(testPath.size(), summary.path.size() - testPath.size() - 1);
+                plotscript << "plot \"" << referencePath << "stats\" using 1:4 with lines "
+                           << "linetype rgb \"#000000ff\" title ''\n"
+                           << "replot \"" << referencePath << "stats\" using 1:2:6 with filledcurves closed "
+                           << "linetype rgb \"#880000ff\" title \"no redundancy\"\n"
+                           << "replot \"" << summary.path << "stats\" using 1:4 with lines "
+                           << "linetype rgb \"#00ff0000\" title ''\n"
+                           << "replot \"" << summary.path << "stats\" using 1:2:6 with filledcurves closed "
+                           << "linetype rgb \"#88ff0000\" title \"" << test << " " << value << "\"\n"
+                           << "pause -1\n";
+            }
+        }
+    }
+    return 0;
+}
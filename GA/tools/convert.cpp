@@ -0,0 +1,93 @@
+#include <cstring> // strcmp
+#include <iostream>
+#include <stdexcept> // runtime_error
+#include <string>
+#include "FacilityLocation/Instance.h"
+
+/*
+ * Convert a facility location instance between the text format and the binary one,
+ * which is mapped in memory when loaded, see FacilityLocation::Instance. The input is
+ * either, its checksum is verified if binary.
+ *
+ * Usage: convert-instance [--precision double|float|fixed16]
+ *                         [--layout facility-major|customer-major|blocked] [--text] INPUT OUTPUT
+ * By default, the precision and layout of the input are kept, and the output is binary.
+ */
+
+namespace {
+
+    /**
+     * Options of the command line.
+     */
+    struct Options {
+        std::string precision; /**< Precision of the output, empty to keep the one of the input */
+        std::string layout; /**< Layout of the output, empty to keep the one of the input */
+        bool text; /**< true to write the text format */
+        std::string input; /**< File to convert */
+        std::string output; /**< File to write */
+    };
+
+    bool parseOptions(int argc, char **argv, Options &options) {
+        options.text = false;
+        for (int i = 1; i < argc; ++i) {
+            bool hasValue = i + 1 < argc;
+            if (std::strcmp(argv[i], "--precision") == 0 && hasValue) {
+                options.precision = argv[++i];
+            } else if (std::strcmp(argv[i], "--layout") == 0 && hasValue) {
+                options.layout = argv[++i];
+            } else if (std::strcmp(argv[i], "--text") == 0) {
+                options.text = true;
+            } else if (argv[i][0] != '-' && options.input.empty()) {
+                options.input = argv[i];
+            } else if (argv[i][0] != '-' && options.output.empty()) {
+                options.output = argv[i];
+            } else {
+                return false;
+            }
+        }
+        return !options.input.empty() && !options.output.empty()
+               && (options.precision.empty() || options.precision == "double" || options.precision == "float"
+                   || options.precision == "fixed16")
+               && (options.layout.empty() || options.layout == "facility-major"
+                   || options.layout == "customer-major" || options.layout == "blocked");
+    }
+
+}
+
+int main(int argc, char **argv) {
+    using Instance = FacilityLocation::Instance<0>;
+
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0] << " [--precision double|float|fixed16]"
+                  << " [--layout facility-major|customer-major|blocked] [--text] INPUT OUTPUT" << std::endl;
+        return 1;
+    }
+
+    try {
+        Instance instance = Instance::load(options.input, true);
+        if (options.layout == "facility-major") {
+            instance.setLayout(FacilityLocation::Layout::FacilityMajor);
+        } else if (options.layout == "customer-major") {
+            instance.setLayout(FacilityLocation::Layout::CustomerMajor);
+        } else if (options.layout == "blocked") {
+            instance.setLayout(FacilityLocation::Layout::Blocked);
+        }
+        if (options.precision == "double") {
+            instance.setPrecision(FacilityLocation::Precision::Double);
+        } else if (options.precision == "float") {
+            instance.setPrecision(FacilityLocation::Precision::Float);
+        } else if (options.precision == "fixed16") {
+            instance.setPrecision(FacilityLocation::Precision::Fixed16);
+        }
+
+        if (options.text) {
+            instance.save(options.output);
+            return 0;
+        }
+        return instance.saveBinary(options.output) ? 0 : 1;
+    } catch (const std::runtime_error &error) {
+        std::cerr << error.what() << std::endl;
+        return 1;
+    }
+}